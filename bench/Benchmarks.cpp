@@ -0,0 +1,585 @@
+// Microbenchmarks for the gameplay hot paths.
+//
+// Times the simulation core in isolation over growing entity counts and
+// reports nanoseconds and heap allocations per operation. The core only
+// uses SFML's header-only vector and rect types, so no SFML library has to
+// be linked.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -Isrc -o benchmarks bench/Benchmarks.cpp src/Enemy.cpp src/Bullet.cpp src/Collision.cpp src/Player.cpp src/Animation.cpp src/Level.cpp src/Camera.cpp src/Grenade.cpp src/GameRandom.cpp src/HudText.cpp src/ParticleSystem.cpp src/SimdKernels.cpp src/JobSystem.cpp src/Log.cpp bench/CountingAllocator.cpp -pthread
+//   ./benchmarks [--filter <substring>] [--min-time <seconds>] [--json <file>] [--jobs <workers>]
+//                [--simd <scalar|sse2|avx2>]
+//
+// Every SIMD level the CPU supports is first checked to give bit-identical
+// results to the scalar kernels; the run fails if one does not.
+//
+// The JSON file holds one record per benchmark and entity count, for
+// plotting scaling curves and diffing against a previous run.
+
+#include "Bullet.h"
+#include "Collision.h"
+#include "CountingAllocator.h"
+#include "Enemy.h"
+#include "GameEvents.h"
+#include "GameRandom.h"
+#include "Grenade.h"
+#include "HudText.h"
+#include "JobSystem.h"
+#include "Log.h"
+#include "ParticleSystem.h"
+#include "SimdKernels.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------------
+// Harness
+//------------------------------------------------------------------------------
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const float TICK = 1.0f / 60.0f;
+const float PLAYER_Y = 492.0f; // Player::init height
+const sf::Vector2f PLAYER_POSITION(400.0f, PLAYER_Y);
+// Camera at the start of a level; most of the spread out enemies are outside it
+const sf::FloatRect VIEW(0.0f, 0.0f, 1280.0f, 800.0f);
+
+const int ENEMY_COUNTS[] = { 10, 100, 1000, 10000, 100000 };
+const int BULLET_COUNTS[] = { 20, 100, 1000, 10000, 100000 };
+// 100000 live has to fit in 2 ms a frame: update plus buildVertices under
+// 20 ns a particle
+const int PARTICLE_COUNTS[] = { 1000, 10000, 100000 };
+const int KERNEL_COUNTS[] = { 64, 1000, 100000 };
+
+struct Result {
+    std::string name;
+    int count;            // Entities in the benchmark
+    long long operations; // Operations timed over every repetition
+    double nsPerOp;
+    double allocsPerOp;
+    double bytesPerOp;
+};
+
+struct Options {
+    std::string filter;
+    double minTime;
+    std::string jsonPath;
+};
+
+// Repeats setup (untimed) and run (timed) until minTime of run time was
+// collected. Each run counts as operationsPerRun operations.
+Result measure(const Options& options, const std::string& name, int count, long long operationsPerRun,
+               const std::function<void()>& setup, const std::function<void()>& run) {
+    // Warm up caches and let vectors reach their steady size
+    setup();
+    run();
+
+    double elapsed = 0.0;
+    long long repetitions = 0;
+    long long allocations = 0;
+    long long bytes = 0;
+    while (elapsed < options.minTime || repetitions < 3) {
+        setup();
+
+        allocationCount = 0;
+        allocatedBytes = 0;
+        countAllocations = true;
+        Clock::time_point start = Clock::now();
+        run();
+        Clock::time_point end = Clock::now();
+        countAllocations = false;
+
+        elapsed += std::chrono::duration<double>(end - start).count();
+        allocations += allocationCount;
+        bytes += allocatedBytes;
+        repetitions++;
+    }
+
+    Result result;
+    result.name = name;
+    result.count = count;
+    result.operations = repetitions * operationsPerRun;
+    result.nsPerOp = elapsed * 1e9 / result.operations;
+    result.allocsPerOp = static_cast<double>(allocations) / result.operations;
+    result.bytesPerOp = static_cast<double>(bytes) / result.operations;
+    return result;
+}
+
+// Enemies spread around the player, so the set mixes idle, walking and attacking
+void spawnEnemies(EnemyManager& enemies, int count) {
+    GameRandom random(count);
+    for (int i = 0; i < count; i++) {
+        float x = PLAYER_POSITION.x + random.nextFloat(-2000.0f, 2000.0f);
+        enemies.spawn(static_cast<EnemyType>(random.nextInt(0, 1)), x, PLAYER_Y, x > PLAYER_POSITION.x);
+    }
+}
+
+// Bullets at the height of the enemy hitboxes, spread over the same range
+void fireBullets(BulletManager& bullets, int count) {
+    GameRandom random(count + 1);
+    const float hitboxCenterY = PLAYER_Y + 128.0f * 3.0f / 2.0f - 100.0f;
+    for (int i = 0; i < count; i++) {
+        float x = PLAYER_POSITION.x + random.nextFloat(-2000.0f, 2000.0f);
+        // fireBullet offsets the muzzle, undo it so the bullet lands on x
+        bullets.fireBullet(x + 254.0f, hitboxCenterY - 2.5f + 217.0f, true);
+    }
+}
+
+// Enemy arrays and boxes for the SIMD kernels. Every few entries sit
+// exactly on a range or box edge, where a kernel rounding differently
+// from the scalar one would classify them the other way.
+struct KernelInput {
+    std::vector<float> x;
+    std::vector<float> attackRange;
+    std::vector<float> detectionRange;
+    std::vector<float> minY;
+    std::vector<float> maxY;
+};
+
+KernelInput makeKernelInput(int count) {
+    GameRandom random(count + 3);
+    KernelInput input;
+    for (int i = 0; i < count; i++) {
+        float x = PLAYER_POSITION.x + random.nextFloat(-2000.0f, 2000.0f);
+        switch (i % 8) {
+        case 1: x = PLAYER_POSITION.x + 50.0f; break;    // Attack range
+        case 3: x = PLAYER_POSITION.x - 1000.0f; break;  // Detection range
+        case 5: x = PLAYER_POSITION.x; break;
+        case 7: x = -0.0f; break;
+        }
+        float minY = random.nextFloat(0.0f, 800.0f);
+        input.x.push_back(x);
+        input.attackRange.push_back(50.0f);
+        input.detectionRange.push_back(1000.0f);
+        input.minY.push_back(i % 4 == 2 ? 400.0f : minY); // Touching the query box, not overlapping
+        input.maxY.push_back(minY + random.nextFloat(1.0f, 200.0f));
+    }
+    return input;
+}
+
+// Everything the kernels write for one input
+struct KernelOutput {
+    std::vector<unsigned char> ranges;
+    std::vector<int> overlaps;
+};
+
+void runKernels(const KernelInput& input, KernelOutput& output) {
+    int count = static_cast<int>(input.x.size());
+    output.ranges.assign(count, 0);
+    output.overlaps.assign(count, -1);
+    classifyEnemyRanges(input.x.data(), input.attackRange.data(), input.detectionRange.data(), count, PLAYER_POSITION.x,
+                        output.ranges.data());
+    output.overlaps.resize(selectOverlapsY(input.minY.data(), input.maxY.data(), count, 200.0f, 400.0f,
+                                           output.overlaps.data()));
+}
+
+bool sameOutput(const KernelOutput& a, const KernelOutput& b) {
+    return a.ranges == b.ranges && a.overlaps == b.overlaps;
+}
+
+// Compare every supported level with the scalar kernels, over every tail
+// length of both vector widths and one long run
+bool verifyKernels(SimdLevel level) {
+    std::vector<int> counts;
+    for (int count = 0; count <= 40; count++) {
+        counts.push_back(count);
+    }
+    counts.push_back(1000);
+
+    for (int count : counts) {
+        KernelInput input = makeKernelInput(count);
+        KernelOutput expected;
+        setSimdLevel(SIMD_SCALAR);
+        runKernels(input, expected);
+        for (int i = SIMD_SSE2; i <= level; i++) {
+            KernelOutput actual;
+            setSimdLevel(static_cast<SimdLevel>(i));
+            runKernels(input, actual);
+            if (!sameOutput(expected, actual)) {
+                std::cerr << "SIMD kernels at " << getSimdLevelName(static_cast<SimdLevel>(i))
+                          << " differ from scalar for " << count << " entries" << std::endl;
+                setSimdLevel(level);
+                return false;
+            }
+        }
+    }
+    setSimdLevel(level);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Benchmarks
+//------------------------------------------------------------------------------
+
+void benchmarkEnemyInit(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        std::vector<Enemy> enemies(count);
+        results.push_back(measure(options, "Enemy::init", count, count, [] {}, [&] {
+            for (int i = 0; i < count; i++) {
+                enemies[i].init(i % 2 == 0 ? ZOMBIE_1 : ZOMBIE_2, static_cast<float>(i), PLAYER_Y, i % 2 == 0);
+            }
+        }));
+    }
+}
+
+void benchmarkEnemySpawn(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        EnemyManager enemies(count);
+        EnemyManager empty(count);
+        results.push_back(measure(options, "EnemyManager::spawn", count, count, [&] {
+            enemies = empty;
+        }, [&] {
+            spawnEnemies(enemies, count);
+        }));
+    }
+}
+
+void benchmarkEnemyUpdate(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        EnemyManager enemies(count);
+        spawnEnemies(enemies, count);
+        // Enemies keep updating across repetitions, like consecutive ticks
+        results.push_back(measure(options, "Enemy::update", count, count, [] {}, [&] {
+            for (int i = 0; i < count; i++) {
+                enemies.getActiveEnemy(i).update(TICK, PLAYER_POSITION, VIEW);
+            }
+        }));
+    }
+}
+
+// Same work through the JobSystem, scales with --jobs
+void benchmarkEnemyUpdateParallel(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        EnemyManager enemies(count);
+        spawnEnemies(enemies, count);
+        results.push_back(measure(options, "EnemyManager::updateEnemies", count, count, [] {}, [&] {
+            enemies.updateEnemies(TICK, PLAYER_POSITION, VIEW);
+        }));
+    }
+}
+
+// The same update with the kernels forced to scalar and at the active
+// level, row by row, to show what the SIMD kernels buy the whole pass
+void benchmarkEnemyUpdateSimd(const Options& options, std::vector<Result>& results) {
+    const SimdLevel level = getSimdLevel();
+    const SimdLevel levels[] = { SIMD_SCALAR, level };
+    const int levelCount = level == SIMD_SCALAR ? 1 : 2;
+    for (int count : ENEMY_COUNTS) {
+        for (int i = 0; i < levelCount; i++) {
+            EnemyManager enemies(count);
+            spawnEnemies(enemies, count);
+            setSimdLevel(levels[i]);
+            std::string name = std::string("EnemyManager::updateEnemies ") + getSimdLevelName(levels[i]);
+            results.push_back(measure(options, name, count, count, [] {}, [&] {
+                enemies.updateEnemies(TICK, PLAYER_POSITION, VIEW);
+            }));
+        }
+    }
+    setSimdLevel(level);
+}
+
+void benchmarkEnemyRemoval(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        // Every enemy dead with its death animation finished
+        EnemyManager dead(count);
+        spawnEnemies(dead, count);
+        GameEvents events;
+        for (int i = 0; i < count; i++) {
+            dead.getActiveEnemy(i).takeDamage(9999.0f, events);
+        }
+        for (int tick = 0; tick < 120; tick++) {
+            for (int i = 0; i < count; i++) {
+                dead.getActiveEnemy(i).update(TICK, PLAYER_POSITION, VIEW);
+            }
+        }
+
+        EnemyManager enemies(count);
+        results.push_back(measure(options, "EnemyManager::removeDeadEnemies", count, count, [&] {
+            enemies = dead;
+        }, [&] {
+            enemies.removeDeadEnemies();
+        }));
+    }
+}
+
+void benchmarkBulletFire(const Options& options, std::vector<Result>& results) {
+    for (int count : BULLET_COUNTS) {
+        BulletManager bullets(count);
+        BulletManager empty(count);
+        // Copying keeps the capacity, so this is firing into a warm pool
+        results.push_back(measure(options, "BulletManager::fireBullet", count, count, [&] {
+            bullets = empty;
+            bullets.reload();
+        }, [&] {
+            for (int i = 0; i < count; i++) {
+                bullets.fireBullet(static_cast<float>(i % 1280), PLAYER_Y, i % 2 == 0);
+            }
+        }));
+    }
+}
+
+void benchmarkBulletUpdate(const Options& options, std::vector<Result>& results) {
+    for (int count : BULLET_COUNTS) {
+        BulletManager full(count);
+        fireBullets(full, count);
+        BulletManager bullets(count);
+        results.push_back(measure(options, "BulletManager::update", count, count, [&] {
+            bullets = full;
+        }, [&] {
+            bullets.update(TICK, VIEW.left, VIEW.left + VIEW.width);
+        }));
+    }
+}
+
+void benchmarkCollisions(const Options& options, std::vector<Result>& results) {
+    const int pairs = sizeof(ENEMY_COUNTS) / sizeof(ENEMY_COUNTS[0]);
+    for (int i = 0; i < pairs; i++) {
+        int enemyCount = ENEMY_COUNTS[i];
+        int bulletCount = BULLET_COUNTS[i];
+
+        EnemyManager spawned(enemyCount);
+        spawnEnemies(spawned, enemyCount);
+        for (int e = 0; e < enemyCount; e++) {
+            spawned.getActiveEnemy(e).update(TICK, PLAYER_POSITION, VIEW); // Place the hitboxes
+        }
+        BulletManager fired(bulletCount);
+        fireBullets(fired, bulletCount);
+
+        // Hits kill enemies and use up bullets, so each run starts from a copy
+        EnemyManager enemies(enemyCount);
+        BulletManager bullets(bulletCount);
+        CollisionSystem collisions;
+        GameEvents events;
+        results.push_back(measure(options, "CollisionSystem::checkBulletEnemyCollisions", enemyCount,
+                                  enemyCount + bulletCount, [&] {
+            enemies = spawned;
+            bullets = fired;
+            events.clear();
+        }, [&] {
+            collisions.update(enemies);
+            collisions.checkBulletEnemyCollisions(bullets, enemies, events);
+        }));
+    }
+}
+
+// A grenade going off next to the player. Enemies are spread over 4000
+// pixels, so about a tenth of them are inside the blast.
+void benchmarkRadiusDamage(const Options& options, std::vector<Result>& results) {
+    for (int count : ENEMY_COUNTS) {
+        EnemyManager spawned(count);
+        spawnEnemies(spawned, count);
+        for (int e = 0; e < count; e++) {
+            spawned.getActiveEnemy(e).update(TICK, PLAYER_POSITION, VIEW); // Place the hitboxes
+        }
+        sf::FloatRect feet = spawned.getActiveEnemy(0).getHitbox().getBounds();
+        const sf::Vector2f center(PLAYER_POSITION.x, feet.top + feet.height); // On the ground
+
+        // Blasts kill enemies, so each run starts from a copy
+        EnemyManager enemies(count);
+        CollisionSystem collisions;
+        GameEvents events;
+        results.push_back(measure(options, "CollisionSystem::applyRadiusDamage", count, count, [&] {
+            enemies = spawned;
+            events.clear();
+            collisions.update(enemies);
+        }, [&] {
+            collisions.applyRadiusDamage(center, GrenadeManager::EXPLOSION_RADIUS, GrenadeManager::EXPLOSION_DAMAGE,
+                                         enemies, events);
+        }));
+    }
+}
+
+// Effects of every kind spread over the screen, until count are alive or the
+// pools are full. Returns the live count, reporting when it falls short.
+int fillParticles(ParticleSystem& particles, int count) {
+    GameRandom random(count + 2);
+    int effect = 0;
+    int stalled = 0;
+    while (particles.getLiveCount() < count && stalled < EFFECT_COUNT) {
+        int before = particles.getLiveCount();
+        EffectEvent event = { static_cast<GameEffect>(effect), sf::Vector2f(random.nextFloat(0.0f, VIEW.width),
+                              random.nextFloat(0.0f, VIEW.height)), random.nextInt(0, 1) == 1 };
+        particles.emit(event);
+        stalled = particles.getLiveCount() == before ? stalled + 1 : 0;
+        effect = (effect + 1) % EFFECT_COUNT;
+    }
+    if (particles.getLiveCount() < count) {
+        std::cerr << "Particle pools hold " << particles.getLiveCount() << " of the " << count
+                  << " requested" << std::endl;
+    }
+    return particles.getLiveCount();
+}
+
+void benchmarkParticleUpdate(const Options& options, std::vector<Result>& results) {
+    for (int count : PARTICLE_COUNTS) {
+        // Particles expire, so each run starts from the same full pools
+        std::unique_ptr<ParticleSystem> filled(new ParticleSystem());
+        int live = fillParticles(*filled, count);
+        std::unique_ptr<ParticleSystem> particles(new ParticleSystem());
+        results.push_back(measure(options, "ParticleSystem::update", count, live, [&] {
+            *particles = *filled;
+        }, [&] {
+            particles->update(TICK);
+        }));
+    }
+}
+
+void benchmarkParticleVertices(const Options& options, std::vector<Result>& results) {
+    // The explosion strip without textures, every frame on the same (null) page
+    AtlasClip clip;
+    for (int i = 0; i < 9; i++) {
+        AtlasFrame frame = { nullptr, sf::IntRect(i * SpriteAtlas::FRAME_SIZE, 0, SpriteAtlas::FRAME_SIZE, SpriteAtlas::FRAME_SIZE),
+                             sf::Vector2f(0.0f, 0.0f) };
+        clip.frames.push_back(frame);
+    }
+    for (int count : PARTICLE_COUNTS) {
+        std::unique_ptr<ParticleSystem> particles(new ParticleSystem());
+        int live = fillParticles(*particles, count);
+        std::vector<sf::Vertex> vertices(static_cast<std::size_t>(particles->getCapacity()) * 4);
+        results.push_back(measure(options, "ParticleSystem::buildVertices", count, live, [] {}, [&] {
+            particles->buildVertices(clip, nullptr, vertices.data());
+        }));
+    }
+}
+
+void benchmarkKernels(const Options& options, std::vector<Result>& results) {
+    for (int count : KERNEL_COUNTS) {
+        KernelInput input = makeKernelInput(count);
+        KernelOutput output;
+        runKernels(input, output);
+        results.push_back(measure(options, "SimdKernels::classifyEnemyRanges", count, count, [] {}, [&] {
+            classifyEnemyRanges(input.x.data(), input.attackRange.data(), input.detectionRange.data(), count,
+                                PLAYER_POSITION.x, output.ranges.data());
+        }));
+        output.overlaps.resize(count);
+        results.push_back(measure(options, "SimdKernels::selectOverlapsY", count, count, [] {}, [&] {
+            selectOverlapsY(input.minY.data(), input.maxY.data(), count, 200.0f, 400.0f, output.overlaps.data());
+        }));
+    }
+}
+
+void benchmarkHudStrings(const Options& options, std::vector<Result>& results) {
+    const int frames = 1000;
+    std::size_t length = 0;
+    char text[32];
+    results.push_back(measure(options, "HUD strings", 1, frames, [] {}, [&] {
+        for (int frame = 0; frame < frames; frame++) {
+            length += formatAmmo(text, sizeof(text), frame % 20, 20);
+            length += formatHealth(text, sizeof(text), static_cast<float>(frame % 100));
+            length += formatWave(text, sizeof(text), frame % 30);
+            length += formatWaveBanner(text, sizeof(text), frame % 30);
+        }
+    }));
+    if (length == 0) {
+        std::cout << std::endl; // Keep the strings from being optimized away
+    }
+}
+
+void writeJson(const std::string& path, const std::vector<Result>& results) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "Failed to write " << path << std::endl;
+        return;
+    }
+    file << "[\n";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        file << "  {\"name\": \"" << result.name << "\", \"count\": " << result.count
+             << ", \"operations\": " << result.operations
+             << ", \"ns_per_op\": " << result.nsPerOp
+             << ", \"allocs_per_op\": " << result.allocsPerOp
+             << ", \"bytes_per_op\": " << result.bytesPerOp << "}"
+             << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    file << "]\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    options.minTime = 0.2;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            options.minTime = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            options.jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            JobSystem::instance().start(static_cast<unsigned int>(std::atoi(argv[++i])));
+        }
+        else if (std::strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            SimdLevel level;
+            if (!parseSimdLevel(argv[++i], level)) {
+                std::cerr << "Unknown SIMD level " << argv[i] << std::endl;
+                return 1;
+            }
+            setSimdLevel(level);
+        }
+    }
+
+    // Keep the report readable when built with debug logs
+    Logger::instance().setMinLevel(LOG_LEVEL_WARN);
+
+    if (!verifyKernels(getSimdLevel())) {
+        return 1;
+    }
+    std::cout << "SIMD level " << getSimdLevelName(getSimdLevel()) << ", supported "
+              << getSimdLevelName(getSupportedSimdLevel()) << std::endl;
+
+    typedef void (*BenchmarkFunction)(const Options&, std::vector<Result>&);
+    struct Entry {
+        const char* name;
+        BenchmarkFunction function;
+    };
+    const Entry benchmarks[] = {
+        { "Enemy::init", benchmarkEnemyInit },
+        { "EnemyManager::spawn", benchmarkEnemySpawn },
+        { "Enemy::update", benchmarkEnemyUpdate },
+        { "EnemyManager::updateEnemies", benchmarkEnemyUpdateParallel },
+        { "EnemyManager::updateEnemies by SIMD level", benchmarkEnemyUpdateSimd },
+        { "EnemyManager::removeDeadEnemies", benchmarkEnemyRemoval },
+        { "BulletManager::fireBullet", benchmarkBulletFire },
+        { "BulletManager::update", benchmarkBulletUpdate },
+        { "CollisionSystem::checkBulletEnemyCollisions", benchmarkCollisions },
+        { "CollisionSystem::applyRadiusDamage", benchmarkRadiusDamage },
+        { "SimdKernels", benchmarkKernels },
+        { "ParticleSystem::update", benchmarkParticleUpdate },
+        { "ParticleSystem::buildVertices", benchmarkParticleVertices },
+        { "HUD strings", benchmarkHudStrings }
+    };
+
+    std::vector<Result> results;
+    for (const Entry& entry : benchmarks) {
+        if (options.filter.empty() || std::string(entry.name).find(options.filter) != std::string::npos) {
+            entry.function(options, results);
+        }
+    }
+
+    std::cout << std::left << std::setw(46) << "Benchmark" << std::right << std::setw(8) << "Count"
+              << std::setw(14) << "ns/op" << std::setw(14) << "allocs/op" << std::setw(14) << "bytes/op" << std::endl;
+    for (const Result& result : results) {
+        std::cout << std::left << std::setw(46) << result.name << std::right << std::setw(8) << result.count
+                  << std::fixed << std::setprecision(2)
+                  << std::setw(14) << result.nsPerOp << std::setw(14) << result.allocsPerOp
+                  << std::setw(14) << result.bytesPerOp << std::endl;
+    }
+
+    if (!options.jsonPath.empty()) {
+        writeJson(options.jsonPath, results);
+    }
+    return 0;
+}
@@ -0,0 +1,13 @@
+#ifndef COUNTINGALLOCATOR_H
+#define COUNTINGALLOCATOR_H
+
+#include <atomic>
+
+// Global operator new and delete are replaced in CountingAllocator.cpp so
+// the benchmarks can count heap allocations. They live in their own
+// translation unit so they are never inlined against a new expression.
+extern std::atomic<bool> countAllocations;    // Only counted while true
+extern std::atomic<long long> allocationCount;
+extern std::atomic<long long> allocatedBytes;
+
+#endif // COUNTINGALLOCATOR_H
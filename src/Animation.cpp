@@ -0,0 +1,104 @@
+#include "Animation.h"
+
+namespace {
+
+// Frame counts match the strips in Assets/<character>/<name>.png
+const AnimationClip CLIPS[CLIP_COUNT] = {
+    { "Player",   "Idle",     7,  0.15f, ANIMATION_LOOP },
+    { "Player",   "Run",      8,  0.08f, ANIMATION_LOOP },
+    { "Player",   "Shot_2",   4,  0.05f, ANIMATION_LOOP }, // Four frames per 0.2 s shot
+    { "Player",   "Recharge", 13, 0.19f, ANIMATION_HOLD }, // About as long as the reload sound
+    { "Player",   "Dead",     4,  0.15f, ANIMATION_HOLD },
+    { "Player",   "Grenade",  9,  0.06f, ANIMATION_HOLD }, // Leaves the hand on frame 6
+    { "Zombie",   "Idle",     6,  0.1f,  ANIMATION_LOOP },
+    { "Zombie",   "Walk",     10, 0.1f,  ANIMATION_LOOP },
+    { "Zombie",   "Attack",   4,  0.1f,  ANIMATION_LOOP },
+    { "Zombie",   "Dead",     5,  0.1f,  ANIMATION_HOLD },
+    { "Zombie_2", "Idle",     6,  0.1f,  ANIMATION_LOOP },
+    { "Zombie_2", "Walk",     10, 0.1f,  ANIMATION_LOOP },
+    { "Zombie_2", "Attack",   5,  0.1f,  ANIMATION_LOOP },
+    { "Zombie_2", "Dead",     5,  0.1f,  ANIMATION_HOLD }
+};
+
+} // namespace
+
+float AnimationClip::getLength() const {
+    return frameCount * frameDuration;
+}
+
+const AnimationClip& getAnimationClip(AnimationClipId id) {
+    return CLIPS[id];
+}
+
+AnimationPlayer::AnimationPlayer() :
+    clip(0),
+    frame(0),
+    timer(0.0f)
+{
+}
+
+void AnimationPlayer::play(AnimationClipId clip) {
+    if (this->clip != clip) {
+        restart(clip);
+    }
+}
+
+void AnimationPlayer::restart(AnimationClipId clip) {
+    this->clip = static_cast<std::uint16_t>(clip);
+    frame = 0;
+    timer = 0.0f;
+}
+
+bool AnimationPlayer::update(float deltaTime) {
+    // Steps through every frame that is due and keeps the overshoot, so clips
+    // play at their data rate even when a tick is longer than a frame
+    std::uint16_t previous = frame;
+    advance(deltaTime);
+    return frame != previous;
+}
+
+void AnimationPlayer::advance(float elapsed) {
+    const AnimationClip& current = CLIPS[clip];
+    timer += elapsed;
+    if (timer < current.frameDuration) {
+        return;
+    }
+    int frames = static_cast<int>(timer / current.frameDuration);
+    timer -= frames * current.frameDuration;
+
+    int target = frame + frames;
+    if (target < current.frameCount) {
+        frame = static_cast<std::uint16_t>(target);
+    }
+    else if (current.mode == ANIMATION_HOLD) {
+        frame = static_cast<std::uint16_t>(current.frameCount - 1);
+    }
+    else {
+        frame = static_cast<std::uint16_t>(target % current.frameCount);
+    }
+}
+
+AnimationClipId AnimationPlayer::getClip() const {
+    return static_cast<AnimationClipId>(clip);
+}
+
+int AnimationPlayer::getFrame() const {
+    return frame;
+}
+
+bool AnimationPlayer::isFinished() const {
+    const AnimationClip& current = CLIPS[clip];
+    return current.mode == ANIMATION_HOLD && frame == current.frameCount - 1;
+}
+
+void AnimationPlayer::saveState(StateWriter& writer) const {
+    writer.write(clip);
+    writer.write(frame);
+    writer.write(timer);
+}
+
+void AnimationPlayer::loadState(StateReader& reader) {
+    reader.read(clip);
+    reader.read(frame);
+    reader.read(timer);
+}
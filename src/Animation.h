@@ -0,0 +1,74 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <cstdint>
+#include "StateStream.h"
+
+// Every animation in the game. New characters add their clips here and a
+// row to the table in Animation.cpp.
+enum AnimationClipId {
+    CLIP_PLAYER_IDLE,
+    CLIP_PLAYER_RUN,
+    CLIP_PLAYER_SHOOT,
+    CLIP_PLAYER_RELOAD,
+    CLIP_PLAYER_DEAD,
+    CLIP_PLAYER_THROW,
+    CLIP_ZOMBIE_IDLE,
+    CLIP_ZOMBIE_WALK,
+    CLIP_ZOMBIE_ATTACK,
+    CLIP_ZOMBIE_DEAD,
+    CLIP_ZOMBIE_2_IDLE,
+    CLIP_ZOMBIE_2_WALK,
+    CLIP_ZOMBIE_2_ATTACK,
+    CLIP_ZOMBIE_2_DEAD,
+    CLIP_COUNT
+};
+
+enum AnimationMode {
+    ANIMATION_LOOP,
+    ANIMATION_HOLD // Stops on the last frame
+};
+
+// Timing of one clip. The frames themselves live in the SpriteAtlas under
+// character/name; the simulation only needs the counts and durations, so it
+// runs the same without any textures loaded.
+struct AnimationClip {
+    const char* character;
+    const char* name;
+    int frameCount;
+    float frameDuration;
+    AnimationMode mode;
+
+    float getLength() const;
+};
+
+const AnimationClip& getAnimationClip(AnimationClipId id);
+
+// Playback state of one entity, 8 bytes
+class AnimationPlayer {
+public:
+    AnimationPlayer();
+
+    // Switch clips; playing the current clip again keeps its frame
+    void play(AnimationClipId clip);
+    // Start a clip from its first frame, even if it is already playing
+    void restart(AnimationClipId clip);
+    // Returns true when the frame changed
+    bool update(float deltaTime);
+    // Skip ahead by time that was not played, however many frames it spans
+    void advance(float elapsed);
+
+    AnimationClipId getClip() const;
+    int getFrame() const;
+    bool isFinished() const; // A hold clip reached its last frame
+
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
+
+private:
+    std::uint16_t clip;
+    std::uint16_t frame;
+    float timer;
+};
+
+#endif // ANIMATION_H
@@ -0,0 +1,141 @@
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "ResourceCache.h"
+#include "Log.h"
+#include <algorithm>
+
+AssetLoader::AssetLoader() :
+    nextJob(0),
+    finished(0),
+    failed(0)
+{
+}
+
+AssetLoader::~AssetLoader() {
+    // Skip whatever has not started yet, e.g. when the window closes while loading
+    nextJob = jobs.size();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void AssetLoader::add(AssetType type, const std::string& path) {
+    Job job;
+    job.type = type;
+    job.path = path;
+    job.loaded = false;
+    jobs.push_back(job);
+}
+
+void AssetLoader::start(unsigned int workerCount) {
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    // No point in threads that would find the queue empty
+    workerCount = std::min(workerCount, static_cast<unsigned int>(jobs.size()));
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&AssetLoader::runWorker, this);
+    }
+}
+
+void AssetLoader::runWorker() {
+    for (;;) {
+        std::size_t index = nextJob.fetch_add(1);
+        if (index >= jobs.size()) {
+            return;
+        }
+        decode(jobs[index]);
+
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        decoded.push_back(index);
+    }
+}
+
+void AssetLoader::decode(Job& job) {
+    PROFILE_ZONE("Load::decode");
+    switch (job.type) {
+    case ASSET_TEXTURE:
+        job.loaded = job.image.loadFromFile(job.path);
+        break;
+    case ASSET_SOUND_BUFFER:
+        job.soundBuffer = std::make_shared<sf::SoundBuffer>();
+        job.loaded = job.soundBuffer->loadFromFile(job.path);
+        break;
+    case ASSET_FONT:
+        job.font = std::make_shared<sf::Font>();
+        job.loaded = job.font->loadFromFile(job.path);
+        break;
+    }
+}
+
+void AssetLoader::update(sf::Time budget) {
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        pending.insert(pending.end(), decoded.begin(), decoded.end());
+        decoded.clear();
+    }
+
+    // Always upload at least one, so a tiny budget still makes progress
+    sf::Clock clock;
+    std::size_t done = 0;
+    while (done < pending.size()) {
+        finish(jobs[pending[done]]);
+        done++;
+        if (clock.getElapsedTime() >= budget) {
+            break;
+        }
+    }
+    pending.erase(pending.begin(), pending.begin() + done);
+}
+
+void AssetLoader::finish(Job& job) {
+    finished++;
+    if (!job.loaded) {
+        LOG_ERROR("Failed to load asset", LogField("path", job.path));
+        failed++;
+        return;
+    }
+
+    ResourceCache& cache = ResourceCache::instance();
+    switch (job.type) {
+    case ASSET_TEXTURE: {
+        PROFILE_ZONE("Load::upload");
+        std::shared_ptr<sf::Texture> texture = std::make_shared<sf::Texture>();
+        if (!texture->loadFromImage(job.image)) {
+            LOG_ERROR("Failed to upload texture", LogField("path", job.path));
+            failed++;
+            return;
+        }
+        job.image = sf::Image(); // Free the pixels, the GPU has them now
+        cache.addTexture(job.path, texture);
+        break;
+    }
+    case ASSET_SOUND_BUFFER:
+        cache.addSoundBuffer(job.path, job.soundBuffer);
+        job.soundBuffer.reset();
+        break;
+    case ASSET_FONT:
+        cache.addFont(job.path, job.font);
+        job.font.reset();
+        break;
+    }
+}
+
+bool AssetLoader::isFinished() const {
+    return finished == jobs.size();
+}
+
+float AssetLoader::getProgress() const {
+    if (jobs.empty()) {
+        return 1.0f;
+    }
+    return static_cast<float>(finished) / jobs.size();
+}
+
+int AssetLoader::getFailedCount() const {
+    return failed;
+}
+
+unsigned int AssetLoader::getWorkerCount() const {
+    return static_cast<unsigned int>(workers.size());
+}
@@ -0,0 +1,74 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum AssetType {
+    ASSET_TEXTURE,
+    ASSET_SOUND_BUFFER,
+    ASSET_FONT
+};
+
+// Decodes startup assets on a pool of worker threads. Images, sounds and
+// fonts are read and decompressed in parallel; textures still have to be
+// created on the thread owning the GL context, so update() uploads each
+// image as soon as it is ready. Everything ends up in the ResourceCache,
+// where the usual getTexture/getSoundBuffer/getFont calls find it.
+class AssetLoader {
+public:
+    AssetLoader();
+    ~AssetLoader(); // Waits for the workers
+
+    // Queue a file, before start()
+    void add(AssetType type, const std::string& path);
+    // Start decoding. 0 workers means one per hardware thread.
+    void start(unsigned int workerCount = 0);
+
+    // Main thread: upload and cache what the workers finished, spending at
+    // most `budget` on texture uploads so a loading screen keeps drawing
+    void update(sf::Time budget);
+
+    bool isFinished() const;
+    float getProgress() const; // 0 to 1
+    int getFailedCount() const;
+    unsigned int getWorkerCount() const;
+
+private:
+    struct Job {
+        AssetType type;
+        std::string path;
+        bool loaded;
+        sf::Image image; // Decoded pixels, uploaded on the main thread
+        std::shared_ptr<sf::SoundBuffer> soundBuffer;
+        std::shared_ptr<sf::Font> font;
+    };
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void runWorker();
+    void decode(Job& job);
+    void finish(Job& job);
+
+    // Fixed once start() is called; each job is touched by one worker, then
+    // handed to the main thread through the decoded list
+    std::vector<Job> jobs;
+    std::atomic<std::size_t> nextJob;
+    std::vector<std::thread> workers;
+
+    std::mutex decodedMutex;
+    std::vector<std::size_t> decoded; // Job indices waiting for update()
+    std::vector<std::size_t> pending; // Taken from decoded, not uploaded yet (main thread)
+
+    std::size_t finished; // Jobs handed to the cache
+    int failed;
+};
+
+#endif // ASSETLOADER_H
@@ -0,0 +1,70 @@
+#include "BitmapFont.h"
+#include "Log.h"
+#include <algorithm>
+
+BitmapFont::BitmapFont() {
+}
+
+bool BitmapFont::bake(const sf::Font& font, const unsigned int* characterSizes, int sizeCount) {
+    sizes.assign(characterSizes, characterSizes + sizeCount);
+    glyphs.resize(sizes.size() * GLYPH_COUNT);
+
+    // Let sf::Font rasterize every glyph into its page for each size, then
+    // stack the pages into one image
+    std::vector<sf::Image> pages(sizes.size());
+    unsigned int width = 0;
+    unsigned int height = 0;
+    for (std::size_t size = 0; size < sizes.size(); size++) {
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(FIRST_CHAR + i), sizes[size], false);
+            BitmapGlyph& baked = glyphs[size * GLYPH_COUNT + i];
+            baked.bounds = glyph.bounds;
+            baked.textureRect = glyph.textureRect;
+            baked.advance = glyph.advance;
+        }
+        pages[size] = font.getTexture(sizes[size]).copyToImage();
+        width = std::max(width, pages[size].getSize().x);
+        height += pages[size].getSize().y;
+    }
+
+    sf::Image atlas;
+    atlas.create(width, height, sf::Color::Transparent);
+    unsigned int top = 0;
+    for (std::size_t size = 0; size < sizes.size(); size++) {
+        atlas.copy(pages[size], 0, top);
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            glyphs[size * GLYPH_COUNT + i].textureRect.top += static_cast<int>(top);
+        }
+        top += pages[size].getSize().y;
+    }
+
+    if (!texture.loadFromImage(atlas)) {
+        LOG_ERROR("Failed to create the bitmap font texture");
+        return false;
+    }
+    return true;
+}
+
+int BitmapFont::getSizeIndex(unsigned int characterSize) const {
+    for (std::size_t i = 0; i < sizes.size(); i++) {
+        if (sizes[i] == characterSize) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+unsigned int BitmapFont::getCharacterSize(int sizeIndex) const {
+    return sizes[sizeIndex];
+}
+
+const BitmapGlyph& BitmapFont::getGlyph(int sizeIndex, char character) const {
+    if (character < FIRST_CHAR || character > LAST_CHAR) {
+        character = ' ';
+    }
+    return glyphs[sizeIndex * GLYPH_COUNT + (character - FIRST_CHAR)];
+}
+
+const sf::Texture& BitmapFont::getTexture() const {
+    return texture;
+}
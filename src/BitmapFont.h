@@ -0,0 +1,41 @@
+#ifndef BITMAPFONT_H
+#define BITMAPFONT_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+struct BitmapGlyph {
+    sf::FloatRect bounds;    // Relative to the pen position on the baseline
+    sf::IntRect textureRect; // On the atlas texture
+    float advance;
+};
+
+// Printable ASCII of a font, rasterized once at a few fixed sizes into a
+// single texture, so any amount of text in those sizes draws in one batch
+// and laying it out is a table lookup per character.
+class BitmapFont {
+public:
+    static const char FIRST_CHAR = ' ';
+    static const char LAST_CHAR = '~';
+
+    BitmapFont();
+
+    // Needs an active GL context. Returns false if the atlas could not be built.
+    bool bake(const sf::Font& font, const unsigned int* sizes, int sizeCount);
+
+    // Index of a baked size, or -1
+    int getSizeIndex(unsigned int characterSize) const;
+    unsigned int getCharacterSize(int sizeIndex) const;
+    // Characters outside the baked range map to a space
+    const BitmapGlyph& getGlyph(int sizeIndex, char character) const;
+    const sf::Texture& getTexture() const;
+
+private:
+    static const int GLYPH_COUNT = LAST_CHAR - FIRST_CHAR + 1;
+
+    std::vector<unsigned int> sizes;
+    std::vector<BitmapGlyph> glyphs; // GLYPH_COUNT per size
+    sf::Texture texture;
+};
+
+#endif // BITMAPFONT_H
@@ -1,127 +1,150 @@
-#include <SFML/Graphics.hpp>
 #include "Bullet.h"
-#include <iostream>
+#include "Log.h"
 
-// Bullet implementation
-Bullet::Bullet() : speed(0), active(false), facingRight(true), damage(10.0f) {
-    shape.setSize(sf::Vector2f(10.f, 5.f));
-    shape.setFillColor(sf::Color::Yellow);
-    shape.setPosition(0, 0);
-}
+namespace {
 
-Bullet::Bullet(float x, float y, float speed, bool facingRight) 
-    : speed(speed), active(true), facingRight(facingRight), damage(10.0f) {
-    shape.setSize(sf::Vector2f(10.f, 5.f));
-    shape.setFillColor(sf::Color::Yellow);
-    shape.setPosition(x, y);
-}
+const float BULLET_WIDTH = 10.f;
+const float BULLET_HEIGHT = 5.f;
+const float BULLET_SPEED = 600.f;
+const float BULLET_DAMAGE = 10.0f;
 
-void Bullet::update(float deltaTime) {
-    if (active) {
-        float direction = facingRight ? 1.0f : -1.0f;
-        shape.move(direction * speed * deltaTime, 0);
+} // namespace
 
-        // Check if bullet is off-screen
-        if (shape.getPosition().x < 0 || shape.getPosition().x > 1280) {
-            active = false;
-        }
-    }
+BulletManager::BulletManager(int maxBullets) : maxBullets(maxBullets), remainingBullets(maxBullets) {
+    // Start with room for one magazine, more is allocated on demand
+    posX.reserve(maxBullets);
+    prevX.reserve(maxBullets);
+    posY.reserve(maxBullets);
+    velX.reserve(maxBullets);
+    damage.reserve(maxBullets);
+    alive.reserve(maxBullets);
 }
 
-void Bullet::render(sf::RenderWindow& window) {
-    if (active) {
-        window.draw(shape);
+void BulletManager::fireBullet(float x, float y, bool facingRight) {
+    if (remainingBullets <= 0) {
+        LOG_DEBUG("Out of ammo, press R to reload");
+        return;
     }
-}
 
-bool Bullet::isActive() const {
-    return active;
-}
+    // Adjust bullet spawn position based on player’s position and facing direction
+    float bulletOffsetX = facingRight ? -254.f : 254.f; // Adjust this based on where you want the bullet to appear
+    float bulletOffsetY = -217.f; // Adjusted based on the height of the player’s weapon or shooting point
+
+    // Append to the live range, O(1)
+    posX.push_back(x + bulletOffsetX);
+    prevX.push_back(x + bulletOffsetX);
+    posY.push_back(y + bulletOffsetY);
+    velX.push_back(facingRight ? BULLET_SPEED : -BULLET_SPEED);
+    damage.push_back(BULLET_DAMAGE);
+    alive.push_back(1);
+    remainingBullets--;
+}
+
+void BulletManager::update(float deltaTime, float left, float right) {
+    // Drop bullets that hit something since the last update
+    removeInactive();
+
+    const std::size_t count = posX.size();
+    float* x = posX.data();
+    float* px = prevX.data();
+    const float* vx = velX.data();
+    unsigned char* live = alive.data();
+
+    // Straight loops over plain floats so the compiler can vectorize them
+    for (std::size_t i = 0; i < count; i++) {
+        px[i] = x[i];
+        x[i] += vx[i] * deltaTime;
+    }
+    for (std::size_t i = 0; i < count; i++) {
+        // Check if bullet is off-screen
+        live[i] &= static_cast<unsigned char>(x[i] >= left) & static_cast<unsigned char>(x[i] <= right);
+    }
 
-void Bullet::setActive(bool active) {
-    this->active = active;
+    removeInactive();
 }
 
-sf::FloatRect Bullet::getBounds() const {
-    return shape.getGlobalBounds();
+void BulletManager::removeInactive() {
+    for (std::size_t i = 0; i < alive.size(); /* no increment */) {
+        if (alive[i]) {
+            ++i;
+            continue;
+        }
+        // Swap the last bullet into the freed slot
+        posX[i] = posX.back();
+        prevX[i] = prevX.back();
+        posY[i] = posY.back();
+        velX[i] = velX.back();
+        damage[i] = damage.back();
+        alive[i] = alive.back();
+        posX.pop_back();
+        prevX.pop_back();
+        posY.pop_back();
+        velX.pop_back();
+        damage.pop_back();
+        alive.pop_back();
+    }
 }
 
-void Bullet::reset(float x, float y, float speed, bool facingRight) {
-    this->speed = speed;
-    this->active = true;
-    this->facingRight = facingRight;
-    shape.setPosition(x, y);
+int BulletManager::getRemainingBullets() const {
+    return remainingBullets;
 }
 
-float Bullet::getDamage() const {
-    return damage;
+void BulletManager::reload() {
+    remainingBullets = maxBullets;
+    LOG_DEBUG("Reloaded", LogField("bullets", remainingBullets));
 }
 
-// BulletManager implementation
-BulletManager::BulletManager(int maxBullets) : maxBullets(maxBullets), remainingBullets(maxBullets) {
-    bullets = new Bullet[maxBullets];
-    // Initialize all bullets as inactive
-    for (int i = 0; i < maxBullets; i++) {
-        bullets[i].setActive(false);
-    }
+int BulletManager::getMaxBullets() const {
+    return maxBullets;
 }
 
-BulletManager::~BulletManager() {
-    delete[] bullets;
+int BulletManager::getActiveCount() const {
+    return static_cast<int>(posX.size());
 }
 
-void BulletManager::fireBullet(float x, float y, bool facingRight) {
-    if (remainingBullets <= 0) {
-        std::cout << "Out of ammo! Press R to reload." << std::endl;
-        return;
-    }
-
-    // Find an inactive bullet to reuse
-    for (int i = 0; i < maxBullets; i++) {
-        if (!bullets[i].isActive()) {
-            // Adjust bullet spawn position based on player’s position and facing direction
-            float bulletOffsetX = facingRight ? -254.f : 254.f; // Adjust this based on where you want the bullet to appear
-            float bulletOffsetY = -217.f; // Adjusted based on the height of the player’s weapon or shooting point
-
-            bullets[i].reset(x + bulletOffsetX, y + bulletOffsetY, 600.f, facingRight);
-            remainingBullets--;
-            return;
-        }
-    }
+bool BulletManager::isActive(int index) const {
+    return alive[index] != 0;
+}
 
-    // If we get here, all bullets are active (shouldn't happen with proper management)
-    std::cout << "No inactive bullets available!" << std::endl;
+sf::FloatRect BulletManager::getBounds(int index) const {
+    return sf::FloatRect(posX[index], posY[index], BULLET_WIDTH, BULLET_HEIGHT);
 }
 
-void BulletManager::update(float deltaTime) {
-    for (int i = 0; i < maxBullets; i++) {
-        if (bullets[i].isActive()) {
-            bullets[i].update(deltaTime);
-        }
-    }
+sf::FloatRect BulletManager::getBounds(int index, float alpha) const {
+    float x = prevX[index] + (posX[index] - prevX[index]) * alpha;
+    return sf::FloatRect(x, posY[index], BULLET_WIDTH, BULLET_HEIGHT);
 }
 
-void BulletManager::render(sf::RenderWindow& window) {
-    for (int i = 0; i < maxBullets; i++) {
-        if (bullets[i].isActive()) {
-            bullets[i].render(window);
-        }
-    }
+float BulletManager::getDamage(int index) const {
+    return damage[index];
 }
 
-int BulletManager::getRemainingBullets() const {
-    return remainingBullets;
+bool BulletManager::isMovingRight(int index) const {
+    return velX[index] > 0.0f;
 }
 
-void BulletManager::reload() {
-    remainingBullets = maxBullets;
-    std::cout << "Reloaded! Bullets: " << remainingBullets << std::endl;
+void BulletManager::deactivate(int index) {
+    alive[index] = 0;
 }
 
-Bullet* BulletManager::getBullets() const {
-    return bullets;
+void BulletManager::saveState(StateWriter& writer) const {
+    writer.writeVector(posX);
+    writer.writeVector(prevX);
+    writer.writeVector(posY);
+    writer.writeVector(velX);
+    writer.writeVector(damage);
+    writer.writeVector(alive);
+    writer.write(maxBullets);
+    writer.write(remainingBullets);
 }
 
-int BulletManager::getMaxBullets() const {
-    return maxBullets;
+void BulletManager::loadState(StateReader& reader) {
+    reader.readVector(posX);
+    reader.readVector(prevX);
+    reader.readVector(posY);
+    reader.readVector(velX);
+    reader.readVector(damage);
+    reader.readVector(alive);
+    reader.read(maxBullets);
+    reader.read(remainingBullets);
 }
@@ -1,41 +1,46 @@
 #ifndef BULLET_H
 #define BULLET_H
-#include <SFML/Graphics.hpp>
-
-class Bullet {
-public:
-    Bullet();
-    Bullet(float x, float y, float speed, bool facingRight);
-    void update(float deltaTime);
-    void render(sf::RenderWindow& window);
-    bool isActive() const;
-    void setActive(bool active);
-    sf::FloatRect getBounds() const;
-    void reset(float x, float y, float speed, bool facingRight);
-    float getDamage() const;
-
-private:
-    sf::RectangleShape shape;
-    float speed;
-    bool active;
-    bool facingRight;
-    float damage;
-};
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include "StateStream.h"
 
+// All bullets stored as parallel arrays. Live bullets are packed into
+// indices [0, getActiveCount()), so firing appends and removal swaps the
+// last bullet into the freed slot. The pool grows on demand.
 class BulletManager {
 public:
     BulletManager(int maxBullets = 20);
-    ~BulletManager();
     void fireBullet(float x, float y, bool facingRight);
-    void update(float deltaTime);
-    void render(sf::RenderWindow& window);
+    // Bullets leaving [left, right] (the camera's view) are dropped
+    void update(float deltaTime, float left, float right);
     int getRemainingBullets() const;
     void reload();
-    Bullet* getBullets() const; // Add getter for bullets array
-    int getMaxBullets() const; // Add getter for maxBullets
+    int getMaxBullets() const; // Magazine size
+
+    // Per bullet access for collision checks
+    int getActiveCount() const;
+    bool isActive(int index) const;
+    sf::FloatRect getBounds(int index) const;
+    sf::FloatRect getBounds(int index, float alpha) const; // alpha blends from the previous tick
+    float getDamage(int index) const;
+    bool isMovingRight(int index) const;
+    void deactivate(int index); // Removed on the next update
+
+    // Replay keyframes
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
 
 private:
-    Bullet* bullets;
+    void removeInactive();
+
+    // Structure of arrays, one entry per live bullet
+    std::vector<float> posX;
+    std::vector<float> prevX; // Position before the last update, for interpolation
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> damage;
+    std::vector<unsigned char> alive;
+
     int maxBullets;
     int remainingBullets;
 };
@@ -0,0 +1,56 @@
+#include "Camera.h"
+#include <algorithm>
+
+const float Camera::VIEW_WIDTH = 1280.0f;
+const float Camera::VIEW_HEIGHT = 800.0f;
+
+Camera::Camera() :
+    center(VIEW_WIDTH / 2.0f, VIEW_HEIGHT / 2.0f),
+    previousCenter(center),
+    worldWidth(VIEW_WIDTH)
+{
+}
+
+void Camera::init(float worldWidth, float targetX) {
+    // A world narrower than the screen just doesn't scroll
+    this->worldWidth = std::max(worldWidth, VIEW_WIDTH);
+    center = sf::Vector2f(clampX(targetX), VIEW_HEIGHT / 2.0f);
+    previousCenter = center;
+}
+
+void Camera::follow(float targetX) {
+    previousCenter = center;
+    center.x = clampX(targetX);
+}
+
+float Camera::clampX(float x) const {
+    return std::min(std::max(x, VIEW_WIDTH / 2.0f), worldWidth - VIEW_WIDTH / 2.0f);
+}
+
+sf::FloatRect Camera::getView() const {
+    return sf::FloatRect(center.x - VIEW_WIDTH / 2.0f, center.y - VIEW_HEIGHT / 2.0f, VIEW_WIDTH, VIEW_HEIGHT);
+}
+
+sf::Vector2f Camera::getCenter() const {
+    return center;
+}
+
+sf::Vector2f Camera::getPreviousCenter() const {
+    return previousCenter;
+}
+
+float Camera::getWorldWidth() const {
+    return worldWidth;
+}
+
+void Camera::saveState(StateWriter& writer) const {
+    writer.write(center);
+    writer.write(previousCenter);
+    writer.write(worldWidth);
+}
+
+void Camera::loadState(StateReader& reader) {
+    reader.read(center);
+    reader.read(previousCenter);
+    reader.read(worldWidth);
+}
@@ -0,0 +1,41 @@
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "StateStream.h"
+
+// Follows the player through a level wider than the screen, scrolling
+// horizontally only and never showing past either end of the world. Part
+// of the simulation, because what it sees bounds bullets and spawns; the
+// render thread only interpolates it into an sf::View.
+class Camera {
+public:
+    static const float VIEW_WIDTH;
+    static const float VIEW_HEIGHT;
+
+    Camera();
+
+    // Jump straight to the target in a world of the given width
+    void init(float worldWidth, float targetX);
+    // Once per tick, after the player moved
+    void follow(float targetX);
+
+    // Visible world rectangle
+    sf::FloatRect getView() const;
+    sf::Vector2f getCenter() const;
+    sf::Vector2f getPreviousCenter() const; // Center at the start of the last tick, for interpolation
+    float getWorldWidth() const;
+
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
+
+private:
+    float clampX(float x) const;
+
+    sf::Vector2f center;
+    sf::Vector2f previousCenter;
+    float worldWidth;
+};
+
+#endif // CAMERA_H
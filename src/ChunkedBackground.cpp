@@ -0,0 +1,167 @@
+#include "ChunkedBackground.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Chunks this far beyond either edge of the view are built ahead of time,
+// so a chunk is ready a few frames before it scrolls in
+const float STREAM_MARGIN = 512.0f;
+
+void appendQuad(std::vector<sf::Vertex>& vertices, float left, float right, float height, float u0, float u1, float v) {
+    const sf::Vertex topLeft(sf::Vector2f(left, 0.0f), sf::Vector2f(u0, 0.0f));
+    const sf::Vertex topRight(sf::Vector2f(right, 0.0f), sf::Vector2f(u1, 0.0f));
+    const sf::Vertex bottomRight(sf::Vector2f(right, height), sf::Vector2f(u1, v));
+    const sf::Vertex bottomLeft(sf::Vector2f(left, height), sf::Vector2f(u0, v));
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+} // namespace
+
+const float ChunkedBackground::CHUNK_WIDTH = 1024.0f;
+
+ChunkedBackground::ChunkedBackground() :
+    worldWidth(0.0f),
+    height(0.0f),
+    useBuffers(false),
+    buildCount(0)
+{
+}
+
+void ChunkedBackground::setLayers(const std::vector<std::shared_ptr<sf::Texture>>& layers, float worldWidth, float height) {
+    if (layers == this->layers && worldWidth == this->worldWidth && height == this->height) {
+        return;
+    }
+    // Checked here rather than in the constructor, it needs the GL context
+    useBuffers = sf::VertexBuffer::isAvailable();
+    this->layers = layers;
+    this->worldWidth = worldWidth;
+    this->height = height;
+    releaseAll();
+}
+
+void ChunkedBackground::draw(sf::RenderTarget& target, const sf::FloatRect& view) {
+    if (layers.empty() || worldWidth <= 0.0f) {
+        return;
+    }
+
+    // Chunks that should be resident
+    int chunkCount = static_cast<int>(std::ceil(worldWidth / CHUNK_WIDTH));
+    int first = std::max(0, static_cast<int>(std::floor((view.left - STREAM_MARGIN) / CHUNK_WIDTH)));
+    int last = std::min(chunkCount - 1, static_cast<int>(std::floor((view.left + view.width + STREAM_MARGIN) / CHUNK_WIDTH)));
+
+    // Recycle the ones that fell out of range
+    for (std::size_t i = 0; i < resident.size(); /* no increment */) {
+        if (resident[i]->index >= first && resident[i]->index <= last) {
+            ++i;
+            continue;
+        }
+        spare.push_back(std::move(resident[i]));
+        resident[i] = std::move(resident.back());
+        resident.pop_back();
+    }
+
+    // Build the ones that came into range
+    for (int index = first; index <= last; index++) {
+        bool found = false;
+        for (const std::unique_ptr<Chunk>& chunk : resident) {
+            found |= chunk->index == index;
+        }
+        if (found) {
+            continue;
+        }
+        std::unique_ptr<Chunk> chunk;
+        if (spare.empty()) {
+            chunk.reset(new Chunk());
+        }
+        else {
+            chunk = std::move(spare.back());
+            spare.pop_back();
+        }
+        build(*chunk, index);
+        resident.push_back(std::move(chunk));
+    }
+
+    // Chunks don't overlap, so only the layers within one need ordering
+    for (const std::unique_ptr<Chunk>& chunk : resident) {
+        float left = chunk->index * CHUNK_WIDTH;
+        if (left >= view.left + view.width || left + CHUNK_WIDTH <= view.left) {
+            continue; // Streamed in ahead, not visible yet
+        }
+        for (std::size_t layer = 0; layer < chunk->layers.size(); layer++) {
+            const ChunkLayer& chunkLayer = chunk->layers[layer];
+            sf::RenderStates states(layers[layer].get());
+            if (useBuffers) {
+                target.draw(chunkLayer.buffer, states);
+            }
+            else {
+                target.draw(chunkLayer.vertices.data(), chunkLayer.vertices.size(), sf::Triangles, states);
+            }
+        }
+    }
+}
+
+int ChunkedBackground::getResidentCount() const {
+    return static_cast<int>(resident.size());
+}
+
+unsigned int ChunkedBackground::getBuildCount() const {
+    return buildCount;
+}
+
+ChunkedBackground::ChunkLayer::ChunkLayer() :
+    buffer(sf::Triangles, sf::VertexBuffer::Static)
+{
+}
+
+void ChunkedBackground::build(Chunk& chunk, int index) {
+    chunk.index = index;
+    chunk.layers.resize(layers.size());
+
+    float left = index * CHUNK_WIDTH;
+    float right = std::min(left + CHUNK_WIDTH, worldWidth);
+    for (std::size_t layer = 0; layer < layers.size(); layer++) {
+        ChunkLayer& chunkLayer = chunk.layers[layer];
+        chunkLayer.vertices.clear();
+
+        // Scaled to the view height, repeated along x. Split at tile edges
+        // so no texture needs to be repeated.
+        sf::Vector2f textureSize(layers[layer]->getSize());
+        if (textureSize.x > 0.0f && textureSize.y > 0.0f) {
+            float tileWidth = textureSize.x * height / textureSize.y;
+            for (int tile = static_cast<int>(left / tileWidth); tile * tileWidth < right; tile++) {
+                float tileLeft = tile * tileWidth;
+                float segmentLeft = std::max(left, tileLeft);
+                float segmentRight = std::min(right, tileLeft + tileWidth);
+                if (segmentRight > segmentLeft) {
+                    appendQuad(chunkLayer.vertices, segmentLeft, segmentRight, height,
+                               (segmentLeft - tileLeft) / tileWidth * textureSize.x,
+                               (segmentRight - tileLeft) / tileWidth * textureSize.x, textureSize.y);
+                }
+            }
+        }
+
+        if (useBuffers) {
+            if (chunkLayer.buffer.getVertexCount() != chunkLayer.vertices.size()) {
+                chunkLayer.buffer.create(chunkLayer.vertices.size());
+            }
+            chunkLayer.buffer.update(chunkLayer.vertices.data());
+        }
+    }
+
+    buildCount++;
+    LOG_DEBUG("Background chunk built", LogField("index", index), LogField("resident", static_cast<int>(resident.size()) + 1));
+}
+
+void ChunkedBackground::releaseAll() {
+    for (std::unique_ptr<Chunk>& chunk : resident) {
+        spare.push_back(std::move(chunk));
+    }
+    resident.clear();
+}
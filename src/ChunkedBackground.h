@@ -0,0 +1,55 @@
+#ifndef CHUNKEDBACKGROUND_H
+#define CHUNKEDBACKGROUND_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <vector>
+
+// Level backgrounds tiled across the whole world, cut into fixed width
+// chunks. A chunk's geometry is baked once into static vertex buffers when
+// it comes near the camera and recycled once it leaves, so memory and draw
+// calls depend on the screen size, not on the length of the level. Render
+// thread only.
+class ChunkedBackground {
+public:
+    static const float CHUNK_WIDTH;
+
+    ChunkedBackground();
+
+    // Layers back to front, each tiled at full view height. Cheap when
+    // nothing changed; otherwise every chunk is rebuilt as it is drawn.
+    void setLayers(const std::vector<std::shared_ptr<sf::Texture>>& layers, float worldWidth, float height);
+    // Stream chunks in and out around the visible rectangle and draw them
+    void draw(sf::RenderTarget& target, const sf::FloatRect& view);
+
+    int getResidentCount() const;
+    unsigned int getBuildCount() const; // Chunks baked so far
+
+private:
+    struct ChunkLayer {
+        ChunkLayer();
+
+        sf::VertexBuffer buffer;
+        std::vector<sf::Vertex> vertices; // Drawn directly without vertex buffer support
+    };
+
+    struct Chunk {
+        int index;
+        std::vector<ChunkLayer> layers;
+    };
+
+    void build(Chunk& chunk, int index);
+    void releaseAll();
+
+    std::vector<std::shared_ptr<sf::Texture>> layers;
+    float worldWidth;
+    float height;
+    bool useBuffers;
+
+    // Held by pointer, moving a vertex buffer would copy it on the GPU
+    std::vector<std::unique_ptr<Chunk>> resident;
+    std::vector<std::unique_ptr<Chunk>> spare; // Released chunks, their buffers are reused
+    unsigned int buildCount;
+};
+
+#endif // CHUNKEDBACKGROUND_H
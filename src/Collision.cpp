@@ -0,0 +1,337 @@
+#include "Collision.h"
+#include "Bullet.h"
+#include "Enemy.h"
+#include "Player.h"
+#include "SimdKernels.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const std::size_t MIN_KERNEL_RUN = 8; // Shorter runs are cheaper to y test one at a time
+
+bool compareMinX(const BroadphaseEntry& a, const BroadphaseEntry& b) {
+    return a.minX < b.minX;
+}
+
+// Strict overlap, same rule as sf::FloatRect::intersects
+bool overlapsY(const BroadphaseEntry& a, const BroadphaseEntry& b) {
+    return a.minY < b.maxY && b.minY < a.maxY;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Broadphase Implementation
+//------------------------------------------------------------------------------
+
+Broadphase::Broadphase() :
+    maxWidth(0.0f),
+    candidateCount(0)
+{
+}
+
+void Broadphase::clear() {
+    entries.clear();
+    maxWidth = 0.0f;
+}
+
+void Broadphase::insert(int id, const sf::FloatRect& bounds) {
+    BroadphaseEntry entry;
+    entry.minX = bounds.left;
+    entry.minY = bounds.top;
+    entry.maxX = bounds.left + bounds.width;
+    entry.maxY = bounds.top + bounds.height;
+    entry.id = id;
+    entries.push_back(entry);
+    maxWidth = std::max(maxWidth, bounds.width);
+}
+
+void Broadphase::build() {
+    // Boxes come in pool order every tick, so this is a full sort. Keeping
+    // last tick's order to insertion sort would need ids that survive
+    // swap-and-pop removal, which the callers' indices do not.
+    std::sort(entries.begin(), entries.end(), compareMinX);
+
+    minYs.resize(entries.size());
+    maxYs.resize(entries.size());
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        minYs[i] = entries[i].minY;
+        maxYs[i] = entries[i].maxY;
+    }
+}
+
+void Broadphase::queryAABB(const sf::FloatRect& bounds, std::vector<int>& results) const {
+    results.clear();
+
+    BroadphaseEntry query;
+    query.minX = bounds.left;
+    query.minY = bounds.top;
+    query.maxX = bounds.left + bounds.width;
+    query.maxY = bounds.top + bounds.height;
+
+    // Nothing starting further left than the widest box can still reach the query
+    BroadphaseEntry first = query;
+    first.minX = query.minX - maxWidth;
+    std::vector<BroadphaseEntry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), first, compareMinX);
+
+    for (; it != entries.end() && it->minX < query.maxX; ++it) {
+        if (it->maxX > query.minX) {
+            candidateCount++;
+            if (overlapsY(*it, query)) {
+                results.push_back(it->id);
+            }
+        }
+    }
+}
+
+void Broadphase::queryRadius(const sf::Vector2f& center, float radius, std::vector<int>& results) const {
+    results.clear();
+
+    // Same sweep as queryAABB over the circle's bounding box
+    float queryMinX = center.x - radius;
+    float queryMaxX = center.x + radius;
+    BroadphaseEntry first = BroadphaseEntry();
+    first.minX = queryMinX - maxWidth;
+    std::vector<BroadphaseEntry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), first, compareMinX);
+
+    const float radiusSquared = radius * radius;
+    for (; it != entries.end() && it->minX <= queryMaxX; ++it) {
+        if (it->maxX < queryMinX) {
+            continue;
+        }
+        candidateCount++;
+
+        // Distance from the center to the closest point of the box
+        float dx = center.x - std::min(std::max(center.x, it->minX), it->maxX);
+        float dy = center.y - std::min(std::max(center.y, it->minY), it->maxY);
+        if (dx * dx + dy * dy <= radiusSquared) {
+            results.push_back(it->id);
+        }
+    }
+}
+
+int Broadphase::queryRay(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance) const {
+    // The ray only covers this x range
+    float endX = origin.x + direction.x * maxDistance;
+    float rayMinX = std::min(origin.x, endX);
+    float rayMaxX = std::max(origin.x, endX);
+
+    BroadphaseEntry first = BroadphaseEntry();
+    first.minX = rayMinX - maxWidth;
+    std::vector<BroadphaseEntry>::const_iterator it = std::lower_bound(entries.begin(), entries.end(), first, compareMinX);
+
+    int nearestId = -1;
+    float nearest = maxDistance;
+    for (; it != entries.end() && it->minX <= rayMaxX; ++it) {
+        if (it->maxX < rayMinX) {
+            continue;
+        }
+        candidateCount++;
+
+        // Slab test, direction is expected to be normalized
+        float tMin = 0.0f;
+        float tMax = nearest;
+        const float origins[2] = { origin.x, origin.y };
+        const float directions[2] = { direction.x, direction.y };
+        const float mins[2] = { it->minX, it->minY };
+        const float maxs[2] = { it->maxX, it->maxY };
+        bool hit = true;
+        for (int axis = 0; axis < 2 && hit; axis++) {
+            if (directions[axis] == 0.0f) {
+                hit = origins[axis] >= mins[axis] && origins[axis] <= maxs[axis];
+                continue;
+            }
+            float t1 = (mins[axis] - origins[axis]) / directions[axis];
+            float t2 = (maxs[axis] - origins[axis]) / directions[axis];
+            tMin = std::max(tMin, std::min(t1, t2));
+            tMax = std::min(tMax, std::max(t1, t2));
+            hit = tMin <= tMax;
+        }
+
+        if (hit) {
+            nearest = tMin;
+            nearestId = it->id;
+        }
+    }
+    return nearestId;
+}
+
+void Broadphase::queryPairs(const Broadphase& other, std::vector<BroadphasePair>& pairs) const {
+    pairs.clear();
+
+    const std::vector<BroadphaseEntry>& a = entries;
+    const std::vector<BroadphaseEntry>& b = other.entries;
+    std::size_t i = 0;
+    std::size_t j = 0;
+
+    overlaps.resize(std::max(std::max(a.size(), b.size()), overlaps.size()));
+
+    // Merge both sorted lists; whichever box starts first takes the run of
+    // boxes in the other list starting before it ends, so each pair is seen once
+    while (i < a.size() && j < b.size()) {
+        if (a[i].minX <= b[j].minX) {
+            std::size_t end = j;
+            while (end < b.size() && b[end].minX < a[i].maxX) {
+                end++;
+            }
+            int count = other.selectOverlaps(j, end, a[i], overlaps.data());
+            for (int n = 0; n < count; n++) {
+                BroadphasePair pair = { a[i].id, b[j + overlaps[n]].id };
+                pairs.push_back(pair);
+            }
+            candidateCount += static_cast<int>(end - j);
+            i++;
+        }
+        else {
+            std::size_t end = i;
+            while (end < a.size() && a[end].minX < b[j].maxX) {
+                end++;
+            }
+            int count = selectOverlaps(i, end, b[j], overlaps.data());
+            for (int n = 0; n < count; n++) {
+                BroadphasePair pair = { a[i + overlaps[n]].id, b[j].id };
+                pairs.push_back(pair);
+            }
+            candidateCount += static_cast<int>(end - i);
+            j++;
+        }
+    }
+}
+
+int Broadphase::selectOverlaps(std::size_t begin, std::size_t end, const BroadphaseEntry& box, int* selected) const {
+    // Long runs go through the kernel, a batch of boxes per compare
+    if (end - begin >= MIN_KERNEL_RUN) {
+        return selectOverlapsY(minYs.data() + begin, maxYs.data() + begin, static_cast<int>(end - begin), box.minY,
+                               box.maxY, selected);
+    }
+    int count = 0;
+    for (std::size_t k = begin; k < end; k++) {
+        if (overlapsY(entries[k], box)) {
+            selected[count++] = static_cast<int>(k - begin);
+        }
+    }
+    return count;
+}
+
+int Broadphase::getEntryCount() const {
+    return static_cast<int>(entries.size());
+}
+
+int Broadphase::getCandidateCount() const {
+    return candidateCount;
+}
+
+void Broadphase::resetCandidateCount() {
+    candidateCount = 0;
+}
+
+//------------------------------------------------------------------------------
+// CollisionSystem Implementation
+//------------------------------------------------------------------------------
+
+CollisionSystem::CollisionSystem() :
+    hits(0)
+{
+}
+
+void CollisionSystem::update(EnemyManager& enemyManager) {
+    enemyBroadphase.clear();
+    enemyBroadphase.resetCandidateCount();
+    bulletBroadphase.resetCandidateCount();
+    hits = 0;
+
+    // Ids are active enemy indices, valid until the next EnemyManager::update
+    int enemyCount = enemyManager.getActiveCount();
+    for (int i = 0; i < enemyCount; ++i) {
+        Enemy& enemy = enemyManager.getActiveEnemy(i);
+        if (enemy.isAlive()) {
+            enemyBroadphase.insert(i, enemy.getHitbox().getBounds());
+        }
+    }
+    enemyBroadphase.build();
+}
+
+// Check collision between bullets and enemies
+void CollisionSystem::checkBulletEnemyCollisions(BulletManager& bulletManager, EnemyManager& enemyManager, GameEvents& events) {
+    bulletBroadphase.clear();
+    int bulletCount = bulletManager.getActiveCount();
+    for (int i = 0; i < bulletCount; i++) {
+        if (bulletManager.isActive(i)) {
+            bulletBroadphase.insert(i, bulletManager.getBounds(i));
+        }
+    }
+    bulletBroadphase.build();
+
+    bulletBroadphase.queryPairs(enemyBroadphase, pairs);
+    for (const BroadphasePair& pair : pairs) {
+        // A bullet only hits one enemy, and an enemy may have died this tick
+        Enemy& enemy = enemyManager.getActiveEnemy(pair.second);
+        if (!bulletManager.isActive(pair.first) || !enemy.isAlive()) {
+            continue;
+        }
+
+        // Apply damage to enemy, blood sprays the way the bullet flew
+        sf::FloatRect bounds = bulletManager.getBounds(pair.first);
+        events.spawnEffect(EFFECT_BLOOD, sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f),
+                           bulletManager.isMovingRight(pair.first));
+        enemy.takeDamage(bulletManager.getDamage(pair.first), events);
+
+        // Deactivate bullet
+        bulletManager.deactivate(pair.first);
+        hits++;
+    }
+}
+
+// Check collision between player and enemies
+void CollisionSystem::checkPlayerEnemyCollisions(Player& player, EnemyManager& enemyManager) {
+    enemyBroadphase.queryAABB(player.getHitbox().getBounds(), results);
+    for (int index : results) {
+        Enemy& enemy = enemyManager.getActiveEnemy(index);
+        if (!enemy.isAlive()) {
+            continue;
+        }
+        hits++;
+
+        // Only take damage if enemy is attacking
+        if (enemy.isAttacking()) {
+            player.takeDamage(enemy.getAttackDamage());
+        }
+    }
+}
+
+int CollisionSystem::applyRadiusDamage(const sf::Vector2f& center, float radius, float maxDamage,
+                                       EnemyManager& enemyManager, GameEvents& events) {
+    enemyBroadphase.queryRadius(center, radius, results);
+
+    int hitCount = 0;
+    for (int index : results) {
+        Enemy& enemy = enemyManager.getActiveEnemy(index);
+        if (!enemy.isAlive()) {
+            continue;
+        }
+
+        // Falloff by distance to the closest point, so big zombies standing
+        // on the grenade take the full blast
+        sf::FloatRect bounds = enemy.getHitbox().getBounds();
+        float dx = center.x - std::min(std::max(center.x, bounds.left), bounds.left + bounds.width);
+        float dy = center.y - std::min(std::max(center.y, bounds.top), bounds.top + bounds.height);
+        float distance = std::sqrt(dx * dx + dy * dy);
+        enemy.takeDamage(maxDamage * std::max(0.0f, 1.0f - distance / radius), events);
+        hitCount++;
+    }
+    hits += hitCount;
+    return hitCount;
+}
+
+const Broadphase& CollisionSystem::getEnemyBroadphase() const {
+    return enemyBroadphase;
+}
+
+int CollisionSystem::getCandidatePairs() const {
+    return enemyBroadphase.getCandidateCount() + bulletBroadphase.getCandidateCount();
+}
+
+int CollisionSystem::getHits() const {
+    return hits;
+}
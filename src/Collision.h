@@ -0,0 +1,92 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "GameEvents.h"
+
+class BulletManager;
+class EnemyManager;
+class Player;
+
+// Axis-aligned box tagged with the caller's id
+struct BroadphaseEntry {
+    float minX, minY, maxX, maxY;
+    int id;
+};
+
+struct BroadphasePair {
+    int first;  // Id from this broadphase
+    int second; // Id from the other broadphase
+};
+
+// Sweep-and-prune broadphase. Boxes are inserted once per tick, sorted by
+// their left edge, and queries only visit the entries whose x interval can
+// overlap. The game scrolls sideways, so this prunes almost everything; long
+// runs of what is left are y tested through the SimdKernels.
+class Broadphase {
+public:
+    Broadphase();
+
+    void clear();
+    void insert(int id, const sf::FloatRect& bounds);
+    void build(); // Sort, call after the last insert of the tick
+
+    // Ids of every box overlapping the rectangle
+    void queryAABB(const sf::FloatRect& bounds, std::vector<int>& results) const;
+    // Ids of every box within radius of center, closest point to the center
+    void queryRadius(const sf::Vector2f& center, float radius, std::vector<int>& results) const;
+    // Id of the nearest box hit by the ray within maxDistance, or -1
+    int queryRay(const sf::Vector2f& origin, const sf::Vector2f& direction, float maxDistance) const;
+    // Every overlapping (this, other) pair, in sweep order
+    void queryPairs(const Broadphase& other, std::vector<BroadphasePair>& pairs) const;
+
+    int getEntryCount() const;
+    // Boxes whose x intervals overlapped, before the y test
+    int getCandidateCount() const;
+    void resetCandidateCount();
+
+private:
+    // Offsets from begin of the entries in [begin, end) overlapping box along
+    // y, in order. selected needs room for end - begin of them.
+    int selectOverlaps(std::size_t begin, std::size_t end, const BroadphaseEntry& box, int* selected) const;
+
+    std::vector<BroadphaseEntry> entries;
+    std::vector<float> minYs; // Copies of the entries' y bounds in sorted order, for the kernels
+    std::vector<float> maxYs;
+    mutable std::vector<int> overlaps; // Scratch for the kernel results
+    float maxWidth; // Widest box, bounds how far back a query has to look
+    mutable int candidateCount;
+};
+
+// Owns the per-tick broadphases and resolves the gameplay collisions
+class CollisionSystem {
+public:
+    CollisionSystem();
+
+    // Rebuild the enemy broadphase, once per tick after enemies moved
+    void update(EnemyManager& enemyManager);
+
+    void checkBulletEnemyCollisions(BulletManager& bulletManager, EnemyManager& enemyManager, GameEvents& events);
+    void checkPlayerEnemyCollisions(Player& player, EnemyManager& enemyManager);
+    // Damage every living enemy within radius, maxDamage at the center
+    // falling off linearly to nothing at the edge. Returns the enemies hit.
+    int applyRadiusDamage(const sf::Vector2f& center, float radius, float maxDamage, EnemyManager& enemyManager,
+                          GameEvents& events);
+
+    const Broadphase& getEnemyBroadphase() const;
+
+    // Counters for the last tick
+    int getCandidatePairs() const;
+    int getHits() const;
+
+private:
+    Broadphase enemyBroadphase;
+    Broadphase bulletBroadphase;
+    std::vector<BroadphasePair> pairs; // Scratch buffers reused every tick
+    std::vector<int> results;
+    int hits;
+};
+
+#endif // COLLISION_H
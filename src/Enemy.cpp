@@ -1,10 +1,30 @@
 #include "Enemy.h"
 #include "Hitbox.h"
-#include <iostream>
-#include <cmath>
-#include <random>
+#include "JobSystem.h"
+#include "Level.h"
+#include "Log.h"
+#include "SimdKernels.h"
+#include <algorithm>
+
+namespace {
+
+const int UPDATE_CHUNK_SIZE = 64; // Enemies per job, smaller hordes update inline
+const int BATCH_SIZE = 64;        // Enemies gathered into the range kernel's arrays at once
+const float CELL_SIZE = 128.0f;     // Untrimmed animation cell, see SpriteAtlas::FRAME_SIZE
+const float SPRITE_SCALE = 3.0f;
+// Enemies this close to the view keep animating, so everything the render
+// thread can draw between two ticks is up to date
+const float ANIMATION_MARGIN = 64.0f;
+
+const AnimationClipId STATE_CLIPS[2][4] = { // [EnemyType][EnemyState]
+    { CLIP_ZOMBIE_IDLE, CLIP_ZOMBIE_WALK, CLIP_ZOMBIE_ATTACK, CLIP_ZOMBIE_DEAD },
+    { CLIP_ZOMBIE_2_IDLE, CLIP_ZOMBIE_2_WALK, CLIP_ZOMBIE_2_ATTACK, CLIP_ZOMBIE_2_DEAD }
+};
+
+} // namespace
 
 Enemy::Enemy() :
+    enemyType(ZOMBIE_1),
     currentState(IDLE),
     facingRight(false),
     speed(100.0f),
@@ -12,84 +32,32 @@ Enemy::Enemy() :
     attackDamage(5.0f),
     attackRange(50.0f),
     detectionRange(1000.0f),
-    frameWidth(128),
-    frameHeight(128),
-    currentFrame(0),
-    totalFrames(0),
-    animationTimer(0.0f),
-    frameDuration(0.1f),
+    suspendedTime(0.0f),
+    onScreen(false),
     attackCooldown(1.0f),
     attackTimer(0.0f),
     isDeathAnimationFinished(false),
     deathRemoveTimer(0.0f),
     deathRemoveDelay(0.5f), // 0.5 second delay after death animation
     
-    hitbox(nullptr)
+    hitbox(sf::Vector2f(100.0f, 164.0f), HITBOX_LAYER_ENEMY, HITBOX_LAYER_PLAYER | HITBOX_LAYER_BULLET) // Same size as player hitbox
 {
 }
 
 Enemy::~Enemy() {
-    if (hitbox) {
-        delete hitbox;
-        hitbox = nullptr;
-    }
-}
-
-void Enemy::loadTextures() {
-    std::string texturePath;
-    switch (enemyType) {
-        case ZOMBIE_1:
-            texturePath = "Assets/Zombie/";
-            break;
-        case ZOMBIE_2:
-            texturePath = "Assets/Zombie_2/";
-            break;
-        default:
-            std::cerr << "Unknown enemy type!" << std::endl;
-            return;
-    }
-
-    if (!idleTexture.loadFromFile(texturePath + "Idle.png")) {
-        std::cerr << "Failed to load idle texture for enemy type " << enemyType << "!" << std::endl;
-    }
-
-    if (!walkTexture.loadFromFile(texturePath + "Walk.png")) {
-        std::cerr << "Failed to load walk texture for enemy type " << enemyType << "!" << std::endl;
-    }
-
-    if (!attackTexture.loadFromFile(texturePath + "Attack.png")) {
-        std::cerr << "Failed to load attack texture for enemy type " << enemyType << "!" << std::endl;
-    }
-
-    if (!deadTexture.loadFromFile(texturePath + "Dead.png")) {
-        std::cerr << "Failed to load dead texture for enemy type " << enemyType << "!" << std::endl;
-    }
-}
-
-void Enemy::initSprite() {
-    sprite.setTexture(idleTexture);
-
-    // Set origin to center bottom
-    sprite.setOrigin(frameWidth / 2.0f, frameHeight);
-
-    // Set initial frame
-    sprite.setTextureRect(sf::IntRect(0, 0, frameWidth, frameHeight));
-
-    // Apply position
-    sprite.setPosition(position);
-
-    // Initial scale
-    // Apply scale
-    sprite.setScale(3.0f, 3.0f);
-    // Adjust x-scale for horizontal flipping
-    if (!facingRight) {
-        sprite.setScale(-3.0f, 3.0f);
-    }
 }
 
 void Enemy::init(EnemyType type, float startX, float playerY, bool spawnOnRight) {
     enemyType = type; // Store the enemy type
 
+    // Pooled enemies are reused, so reset everything a previous life touched
+    health = 30.0f;
+    attackTimer = 0.0f;
+    isDeathAnimationFinished = false;
+    deathRemoveTimer = 0.0f;
+    suspendedTime = 0.0f;
+    onScreen = false;
+
     // Set different speed for each type
     switch (enemyType) {
     case ZOMBIE_1:
@@ -104,43 +72,58 @@ void Enemy::init(EnemyType type, float startX, float playerY, bool spawnOnRight)
     }
 
     // Calculate initial position with y-offset to align feet with player
-    position = sf::Vector2f(startX, playerY + frameHeight * 3.0f / 2.0f);
+    position = sf::Vector2f(startX, playerY + CELL_SIZE * SPRITE_SCALE / 2.0f);
+    previousPosition = position; // No interpolation from the slot's previous life
     facingRight = !spawnOnRight; // Face toward center
 
-    loadTextures();
-    initSprite();
-
-    // Load death sound
-    if (!deathSoundBuffer.loadFromFile("Assets/zombiedeath.mp3")) {
-        std::cerr << "Error loading zombie death sound" << std::endl;
-    } else {
-        deathSound.setBuffer(deathSoundBuffer);
-    }
- 
-     // Create hitbox
-     hitbox = new Hitbox(sf::Vector2f(100.0f, 164.0f)); // Same size as player hitbox
-     hitbox->setPosition(position.x, position.y - 100.0f);
+     // Place hitbox
+     hitbox.setPosition(position.x, position.y - 100.0f);
 
     // Initialize animation for idle
     currentState = IDLE;
-    totalFrames = 15; // Idle animation frames (adjust based on your spritesheet)
-    currentFrame = 0;
-    animationTimer = 0.0f;
+    animation.restart(STATE_CLIPS[enemyType][IDLE]);
+}
+
+void Enemy::update(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& animatedArea) {
+    Enemy* self = this;
+    updateBatch(&self, 1, deltaTime, playerPosition, animatedArea);
+}
+
+void Enemy::updateBatch(Enemy* const* enemies, int count, float deltaTime, const sf::Vector2f& playerPosition,
+                        const sf::FloatRect& animatedArea) {
+    float x[BATCH_SIZE];
+    float attackRanges[BATCH_SIZE];
+    float detectionRanges[BATCH_SIZE];
+    unsigned char ranges[BATCH_SIZE];
+
+    for (int begin = 0; begin < count; begin += BATCH_SIZE) {
+        Enemy* const* batch = enemies + begin;
+        const int size = std::min(BATCH_SIZE, count - begin);
+
+        for (int i = 0; i < size; i++) {
+            x[i] = batch[i]->position.x;
+            attackRanges[i] = batch[i]->attackRange;
+            detectionRanges[i] = batch[i]->detectionRange;
+        }
+        classifyEnemyRanges(x, attackRanges, detectionRanges, size, playerPosition.x, ranges);
+
+        for (int i = 0; i < size; i++) {
+            batch[i]->update(static_cast<EnemyRange>(ranges[i]), deltaTime, playerPosition, animatedArea);
+        }
+    }
 }
 
-void Enemy::update(float deltaTime, const sf::Vector2f& playerPosition) {
+void Enemy::update(EnemyRange range, float deltaTime, const sf::Vector2f& playerPosition,
+                   const sf::FloatRect& animatedArea) {
+    previousPosition = position;
+
     if (!isAlive()) {
         // Handle death animation
-        if (currentState != DEAD) {
-            currentState = DEAD;
-            currentFrame = 0;
-            animationTimer = 0.0f;
-            totalFrames = 12; // Death animation frames
-        }
+        setState(DEAD);
     }
     else {
-        // Update state based on player position
-        updateState(playerPosition);
+        // Update state based on the distance to the player
+        updateState(range);
 
         // Move enemy based on state
         if (currentState == WALKING) {
@@ -150,10 +133,7 @@ void Enemy::update(float deltaTime, const sf::Vector2f& playerPosition) {
 
         // Update facing direction based on player position
         bool shouldFaceRight = playerPosition.x > position.x;
-        if (shouldFaceRight != facingRight) {
-            facingRight = shouldFaceRight;
-            sprite.setScale(facingRight ? 1.0f : -1.0f, 1.0f);
-        }
+        facingRight = shouldFaceRight;
 
         // Update attack timer
         if (attackTimer > 0) {
@@ -161,155 +141,78 @@ void Enemy::update(float deltaTime, const sf::Vector2f& playerPosition) {
         }
     }
 
-    // Update animation
-    updateAnimation(deltaTime);
+    // Update animation, the death clip holds on its last frame. Off screen
+    // the time is only banked and played in one step once the enemy is back.
+    // The dying always animate, their removal waits for the clip to end.
+    sf::FloatRect bounds = getSpriteBounds();
+    onScreen = bounds.left < animatedArea.left + animatedArea.width && animatedArea.left < bounds.left + bounds.width &&
+               bounds.top < animatedArea.top + animatedArea.height && animatedArea.top < bounds.top + bounds.height;
+    if (onScreen || currentState == DEAD) {
+        if (suspendedTime > 0.0f) {
+            animation.advance(suspendedTime);
+            suspendedTime = 0.0f;
+        }
+        animation.update(deltaTime);
+    }
+    else {
+        suspendedTime += deltaTime;
+    }
+    if (currentState == DEAD && animation.isFinished()) {
+        isDeathAnimationFinished = true;
+    }
 
     // Update death remove timer if death animation is finished
     if (isDeathAnimationFinished) {
         deathRemoveTimer += deltaTime;
     }
 
-    // Update sprite position
-    sprite.setPosition(position);
-
     // Update hitbox position
-    if (hitbox) {
-        hitbox->setPosition(position.x, position.y - 100.0f);
-    }
+    hitbox.setPosition(position.x, position.y - 100.0f);
 }
 
-void Enemy::updateState(const sf::Vector2f& playerPosition) {
-    float distanceToPlayer = std::abs(playerPosition.x - position.x);
-
-    if (distanceToPlayer <= attackRange) {
+void Enemy::updateState(EnemyRange range) {
+    if (range == ENEMY_IN_ATTACK_RANGE) {
         // Player is in attack range
         if (attackTimer <= 0) {
+            // Every swing starts the attack clip over
             currentState = ATTACKING;
             attackTimer = attackCooldown;
-            currentFrame = 0; // Reset animation frame
-            animationTimer = 0.0f; // Reset animation timer
-            totalFrames = 8; // Attack animation frames
-            frameDuration = 0.1f; // Default duration for attack animation
-            sprite.setTexture(attackTexture); // Set texture immediately
-            sprite.setTextureRect(sf::IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight)); // Set initial frame
-            // Reapply scale
-            sprite.setScale(3.0f, 3.0f);
-            if (!facingRight) {
-                sprite.setScale(-3.0f, 3.0f);
-            }
+            animation.restart(STATE_CLIPS[enemyType][ATTACKING]);
+            suspendedTime = 0.0f;
         }
         else if (currentState != ATTACKING) {
-            currentState = IDLE;
-            currentFrame = 0; // Reset animation frame
-            animationTimer = 0.0f; // Reset animation timer
-            frameDuration = 0.1f; // Default duration for idle
-            sprite.setTexture(idleTexture); // Set texture immediately
-            sprite.setTextureRect(sf::IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight)); // Set initial frame
-            // Reapply scale
-            sprite.setScale(3.0f, 3.0f);
-            if (!facingRight) {
-                sprite.setScale(-3.0f, 3.0f);
-            }
+            setState(IDLE);
         }
     }
-    else if (distanceToPlayer <= detectionRange) {
+    else if (range == ENEMY_IN_DETECTION_RANGE) {
         // Player is detected but not in attack range
-        if (currentState != WALKING) { // Only reset if changing to WALKING
-            currentState = WALKING;
-            currentFrame = 0; // Reset animation frame
-            animationTimer = 0.0f; // Reset animation timer
-            totalFrames = 10; // Walk animation frames
-            frameDuration = 0.1f; // Default duration for walking
-            sprite.setTexture(walkTexture); // Set texture immediately
-            sprite.setTextureRect(sf::IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight)); // Set initial frame
-            // Reapply scale
-            sprite.setScale(3.0f, 3.0f);
-            if (!facingRight) {
-                sprite.setScale(-3.0f, 3.0f);
-            }
-        }
+        setState(WALKING);
     }
     else {
         // Player is not detected
-        if (currentState != IDLE) { // Only reset if changing to IDLE
-            currentState = IDLE;
-            currentFrame = 0; // Reset animation frame
-            animationTimer = 0.0f; // Reset animation timer
-            totalFrames = 15; // Idle animation frames
-            frameDuration = 0.1f; // Default duration for idle
-            sprite.setTexture(idleTexture); // Set texture immediately
-            sprite.setTextureRect(sf::IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight)); // Set initial frame
-            // Reapply scale
-            sprite.setScale(3.0f, 3.0f);
-            if (!facingRight) {
-                sprite.setScale(-3.0f, 3.0f);
-            }
-        }
+        setState(IDLE);
     }
 }
 
-void Enemy::updateAnimation(float deltaTime) {
-    animationTimer += deltaTime;
-
-    if (animationTimer >= frameDuration) {
-        // Move to next frame
-        currentFrame = (currentFrame + 1) % totalFrames;
-        animationTimer = 0.0f;
-
-        // Check if death animation is complete
-        if (currentState == DEAD && currentFrame >= totalFrames - 1) {
-            isDeathAnimationFinished = true;
-            currentFrame = totalFrames - 1; // Stay on last frame
-        }
-
-        // Update texture based on state
-        sf::Texture* currentTexture = nullptr;
-
-        switch (currentState) {
-        case IDLE:
-            currentTexture = &idleTexture;
-            break;
-        case WALKING:
-            currentTexture = &walkTexture;
-            break;
-        case ATTACKING:
-            currentTexture = &attackTexture;
-            break;
-        case DEAD:
-            currentTexture = &deadTexture;
-            break;
-        }
-
-        if (currentTexture) {
-            sprite.setTexture(*currentTexture);
-            sprite.setTextureRect(sf::IntRect(currentFrame * frameWidth, 0, frameWidth, frameHeight));
-            // Reapply scale after changing texture
-            sprite.setScale(3.0f, 3.0f);
-            if (!facingRight) {
-                sprite.setScale(-3.0f, 3.0f);
-            }
-        }
+void Enemy::setState(EnemyState state) {
+    AnimationClipId clip = STATE_CLIPS[enemyType][state];
+    if (animation.getClip() != clip) {
+        suspendedTime = 0.0f; // Banked time belonged to the old clip
     }
+    currentState = state;
+    animation.play(clip);
 }
 
-void Enemy::draw(sf::RenderWindow& window) {
-    window.draw(sprite);
-
-    // Debug: Draw hitbox
-    // if (hitbox) {
-    //     hitbox->draw(window);
-    // }
-}
-
-void Enemy::takeDamage(float damage) {
+void Enemy::takeDamage(float damage, GameEvents& events) {
     if (isAlive()) {
         health -= damage;
         if (health <= 0) {
             health = 0;
-            currentState = DEAD;
-            currentFrame = 0;
-            animationTimer = 0.0f;
-            deathSound.play(); // Play death sound
+            setState(DEAD);
+            events.playSound(SOUND_ZOMBIE_DEATH, position); // Play death sound
+            sf::FloatRect bounds = hitbox.getBounds();
+            events.spawnEffect(EFFECT_BLOOD_BURST, sf::Vector2f(bounds.left + bounds.width / 2.0f, bounds.top + bounds.height / 2.0f),
+                               facingRight);
         }
     }
 }
@@ -326,15 +229,15 @@ sf::Vector2f Enemy::getPosition() const {
     return position;
 }
 
-sf::FloatRect Enemy::getBounds() const {
-    return sprite.getGlobalBounds();
+sf::Vector2f Enemy::getPreviousPosition() const {
+    return previousPosition;
 }
 
 float Enemy::getAttackDamage() const {
     return attackDamage;
 }
 
-Hitbox* Enemy::getHitbox() const {
+const Hitbox& Enemy::getHitbox() const {
     return hitbox;
 }
 
@@ -342,55 +245,155 @@ bool Enemy::isAttacking() const {
     return currentState == ATTACKING;
 }
 
+bool Enemy::isOnScreen() const {
+    return onScreen;
+}
+
+sf::FloatRect Enemy::getSpriteBounds() const {
+    // Feet on the bottom center of the cell
+    const float size = CELL_SIZE * SPRITE_SCALE;
+    return sf::FloatRect(position.x - size / 2.0f, position.y - size, size, size);
+}
+
+EnemyType Enemy::getType() const {
+    return enemyType;
+}
+
+EnemyState Enemy::getState() const {
+    return currentState;
+}
+
+AnimationClipId Enemy::getAnimation() const {
+    return animation.getClip();
+}
+
+int Enemy::getCurrentFrame() const {
+    return animation.getFrame();
+}
+
+bool Enemy::isFacingRight() const {
+    return facingRight;
+}
+
+void Enemy::saveState(StateWriter& writer) const {
+    writer.write(enemyType);
+    writer.write(currentState);
+    writer.write(facingRight);
+    writer.write(speed);
+    writer.write(health);
+    writer.write(attackDamage);
+    writer.write(attackRange);
+    writer.write(detectionRange);
+    animation.saveState(writer);
+    writer.write(suspendedTime);
+    writer.write(onScreen);
+    writer.write(attackCooldown);
+    writer.write(attackTimer);
+    writer.write(isDeathAnimationFinished);
+    writer.write(deathRemoveTimer);
+    writer.write(deathRemoveDelay);
+    writer.write(position);
+    writer.write(previousPosition);
+    hitbox.saveState(writer);
+}
+
+void Enemy::loadState(StateReader& reader) {
+    reader.read(enemyType);
+    reader.read(currentState);
+    reader.read(facingRight);
+    reader.read(speed);
+    reader.read(health);
+    reader.read(attackDamage);
+    reader.read(attackRange);
+    reader.read(detectionRange);
+    animation.loadState(reader);
+    reader.read(suspendedTime);
+    reader.read(onScreen);
+    reader.read(attackCooldown);
+    reader.read(attackTimer);
+    reader.read(isDeathAnimationFinished);
+    reader.read(deathRemoveTimer);
+    reader.read(deathRemoveDelay);
+    reader.read(position);
+    reader.read(previousPosition);
+    hitbox.loadState(reader);
+}
+
 //------------------------------------------------------------------------------
 // EnemyManager Implementation
 //------------------------------------------------------------------------------
 
-EnemyManager::EnemyManager() :
+EnemyManager::EnemyManager(int maxEnemies) :
+    pool(maxEnemies),
+    generations(maxEnemies, 0),
+    level(&LevelDefinition::getDefault()),
     spawnTimer(0.0f),
-    spawnInterval(2.0f),
-    maxEnemies(20),
+    maxEnemies(maxEnemies),
     waveDelayTimer(0.0f),
     waveDelay(3.0f),
     isWaveTransitioning(false),
     currentWaveNumber(1),
-    enemiesKilledThisWave(0)
-{}
+    enemiesKilledThisWave(0),
+    levelComplete(false)
+{
+    // Hand out low slots first
+    freeSlots.reserve(maxEnemies);
+    for (int i = maxEnemies - 1; i >= 0; i--) {
+        freeSlots.push_back(static_cast<std::uint32_t>(i));
+    }
+    activeSlots.reserve(maxEnemies);
+}
 
 EnemyManager::~EnemyManager() {
-    for (std::vector<Enemy*>::iterator it = enemies.begin(); it != enemies.end(); ++it) {
-        delete *it;
-    }
-    enemies.clear();
 }
 
 void EnemyManager::init() {
+    init(LevelDefinition::getDefault());
+}
+
+void EnemyManager::init(const LevelDefinition& level) {
+    this->level = &level;
     currentWaveNumber = 1;
-    spawnInterval = 2.0f;
+    enemiesKilledThisWave = 0;
+    spawnTimer = 0.0f;
+    waveDelay = level.waveDelay;
+    waveDelayTimer = 0.0f;
+    isWaveTransitioning = false;
+    levelComplete = false;
+}
 
-    // Load font for wave transition text
-    if (!waveFont.loadFromFile("Assets/pixelFont.ttf")) { // Replace with your actual font path
-        std::cerr << "Failed to load font!" << std::endl;
-    }
+void EnemyManager::startLevel(const LevelDefinition& level) {
+    init(level);
+    isWaveTransitioning = true;
+}
 
-    // Set up wave transition text properties
-    waveTransitionText.setFont(waveFont);
-    waveTransitionText.setCharacterSize(50);  // Font size
-    waveTransitionText.setFillColor(sf::Color::White);  // Text color
-    waveTransitionText.setString("Wave 1"); // Initial wave text
-    waveTransitionText.setPosition(640, 360);  // Centered position on screen
+void EnemyManager::setLevel(const LevelDefinition& level) {
+    this->level = &level;
 }
 
+const LevelDefinition& EnemyManager::getLevel() const {
+    return *level;
+}
+
+bool EnemyManager::isLevelComplete() const {
+    return levelComplete;
+}
 
-void EnemyManager::update(float deltaTime, const sf::Vector2f& playerPosition) {
-    // If wave transition is in progress, update the delay timer
+
+void EnemyManager::update(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& view, GameRandom& random,
+                          GameEvents& events) {
+    // Update existing enemies
+    sf::FloatRect animatedArea(view.left - ANIMATION_MARGIN, view.top - ANIMATION_MARGIN,
+                               view.width + 2.0f * ANIMATION_MARGIN, view.height + 2.0f * ANIMATION_MARGIN);
+    updateEnemies(deltaTime, playerPosition, animatedArea);
+
+    // If wave transition is in progress, update the delay timer. The last
+    // wave's zombies finish dying under the banner, so none carry over.
     if (isWaveTransitioning) {
+        removeDeadEnemies();
         waveDelayTimer += deltaTime;
 
-        // Set wave transition text based on the current wave
-        waveTransitionText.setString("Wave " + std::to_string(currentWaveNumber));
-
-        if (waveDelayTimer >= waveDelay) {
+        if (waveDelayTimer >= waveDelay && activeSlots.empty()) {
             // End wave transition, allow spawning enemies
             isWaveTransitioning = false;
             waveDelayTimer = 0.0f; // Reset the timer
@@ -398,17 +401,17 @@ void EnemyManager::update(float deltaTime, const sf::Vector2f& playerPosition) {
         return; // Skip further updates if wave transition is in progress
     }
 
-    // Update existing enemies
-    for (auto& enemy : enemies) {
-        if (enemy) {
-            enemy->update(deltaTime, playerPosition);
-        }
+    // Remaining zombies finish dying once the level is done
+    if (levelComplete) {
+        removeDeadEnemies();
+        return;
     }
 
-    // Handle enemy spawning
+    // Handle enemy spawning, faster as the wave's quota fills up
+    const WaveDefinition& wave = level->getWave(currentWaveNumber);
     spawnTimer += deltaTime;
-    if (spawnTimer >= spawnInterval && static_cast<int>(enemies.size()) < maxEnemies) {
-        spawnEnemy(playerPosition);
+    if (spawnTimer >= wave.getSpawnInterval(enemiesKilledThisWave) && !freeSlots.empty()) {
+        spawnEnemy(playerPosition, view, random);
         spawnTimer = 0.0f;
     }
 
@@ -416,66 +419,79 @@ void EnemyManager::update(float deltaTime, const sf::Vector2f& playerPosition) {
     removeDeadEnemies();
 
     // Checks for wave increase
-    if (enemiesKilledThisWave >= 10 * currentWaveNumber) {
-        increaseWave();
+    if (isWaveCleared()) {
+        if (level->isLastWave(currentWaveNumber)) {
+            killAll(events);
+            levelComplete = true;
+            return;
+        }
+        increaseWave(events);
         enemiesKilledThisWave = 0;
         isWaveTransitioning = true; // Start wave transition
     }
 }
 
-void EnemyManager::render(sf::RenderWindow& window) {
-    for (std::vector<Enemy*>::iterator it = enemies.begin(); it != enemies.end(); ++it) {
-        if (*it) {
-            (*it)->draw(window);
+void EnemyManager::updateEnemies(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& animatedArea) {
+    JobSystem::instance().parallelFor(static_cast<int>(activeSlots.size()), UPDATE_CHUNK_SIZE, [&](int begin, int end) {
+        Enemy* chunk[UPDATE_CHUNK_SIZE];
+        for (int first = begin; first < end; first += UPDATE_CHUNK_SIZE) {
+            int size = std::min(UPDATE_CHUNK_SIZE, end - first);
+            for (int i = 0; i < size; i++) {
+                chunk[i] = &pool[activeSlots[first + i]];
+            }
+            Enemy::updateBatch(chunk, size, deltaTime, playerPosition, animatedArea);
         }
-    }
-
-    // If wave transition is in progress, draw wave transition text
-    if (isWaveTransitioning) {
-        std::cout << "Drawing transition text\n";
-        window.draw(waveTransitionText);
-    }
+    });
 }
 
-void EnemyManager::spawnEnemy(const sf::Vector2f& playerPosition) {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> sideDist(0, 1); // 0 for left, 1 for right
-    std::uniform_real_distribution<float> offsetDist(100.0f, 300.0f);
-
-    // Determine which enemy types to spawn based on current wave
-    std::uniform_int_distribution<> typeDist(0, (currentWaveNumber > 1 ? 1 : 0));
-
-    // Decide which side to spawn on
-    bool spawnOnRight = sideDist(gen) == 1;
+void EnemyManager::spawnEnemy(const sf::Vector2f& playerPosition, const sf::FloatRect& view, GameRandom& random) {
+    // Pick one of the level's spawn zones
+    const SpawnZone& zone = level->zones[random.nextInt(0, static_cast<int>(level->zones.size()) - 1)];
 
     // Calculate spawn position
     float spawnX;
-    if (spawnOnRight) {
-        spawnX = playerPosition.x + 1280.0f / 2.0f + offsetDist(gen); // Right side of screen
+    if (zone.right) {
+        spawnX = view.left + view.width + random.nextFloat(zone.minDistance, zone.maxDistance); // Right side of screen
     }
     else {
-        spawnX = playerPosition.x - 1280.0f / 2.0f - offsetDist(gen); // Left side of screen
+        spawnX = view.left - random.nextFloat(zone.minDistance, zone.maxDistance); // Left side of screen
     }
 
-    // Randomly select enemy type based on current wave
-    EnemyType enemyType = static_cast<EnemyType>(typeDist(gen));
+    // Randomly select enemy type from the wave's roster
+    const WaveDefinition& wave = level->getWave(currentWaveNumber);
+    EnemyType enemyType = wave.pickType(random.nextInt(0, wave.totalWeight - 1));
 
-    // Create and initialize new enemy
-    Enemy* newEnemy = new Enemy();
-    newEnemy->init(enemyType, spawnX, playerPosition.y, spawnOnRight);
+    spawn(enemyType, spawnX, playerPosition.y, zone.right);
+}
+
+Enemy* EnemyManager::spawn(EnemyType type, float startX, float playerY, bool spawnOnRight) {
+    // Reuse a free pool slot, spawning never allocates
+    if (freeSlots.empty()) {
+        return nullptr;
+    }
+    std::uint32_t slot = freeSlots.back();
+    freeSlots.pop_back();
+    pool[slot].init(type, startX, playerY, spawnOnRight);
 
-    enemies.push_back(newEnemy);
+    activeSlots.push_back(slot);
+    return &pool[slot];
 }
 
 void EnemyManager::removeDeadEnemies() {
-    for (size_t i = 0; i < enemies.size(); /* no increment */) {
-        if (enemies[i]->canBeRemoved()) {
-            if (!enemies[i]->isAlive()) {
+    for (size_t i = 0; i < activeSlots.size(); /* no increment */) {
+        std::uint32_t slot = activeSlots[i];
+        if (pool[slot].canBeRemoved()) {
+            // Zombies killed by a wave or level change don't count for the next
+            if (!pool[slot].isAlive() && !isWaveTransitioning && !levelComplete) {
                 enemiesKilledThisWave++;
             }
-            delete enemies[i];
-            enemies.erase(enemies.begin() + i);
+            // Invalidate outstanding handles and recycle the slot
+            generations[slot]++;
+            freeSlots.push_back(slot);
+
+            // Swap-and-pop, O(1)
+            activeSlots[i] = activeSlots.back();
+            activeSlots.pop_back();
         }
         else {
             ++i;
@@ -483,17 +499,19 @@ void EnemyManager::removeDeadEnemies() {
     }
 }
 
-void EnemyManager::increaseWave() {
+void EnemyManager::increaseWave(GameEvents& events) {
     currentWaveNumber++;
-    // Make spawning faster as waves progress
-    spawnInterval = std::max(0.5f, spawnInterval * 0.5f);
 
     isWaveTransitioning = true;
     waveDelayTimer = 0.0f;  // Reset the timer for the next transition
 
-    for (Enemy* enemy : enemies) {
-        if (enemy && enemy->isAlive()) {
-            enemy->takeDamage(9999.0f);
+    killAll(events);
+}
+
+void EnemyManager::killAll(GameEvents& events) {
+    for (std::uint32_t slot : activeSlots) {
+        if (pool[slot].isAlive()) {
+            pool[slot].takeDamage(9999.0f, events);
         }
     }
 }
@@ -506,18 +524,99 @@ int EnemyManager::getCurrentWave() const {
 int EnemyManager::getRemainingEnemies() const {
     // Count alive enemies
     int count = 0;
-    for (std::vector<Enemy*>::const_iterator it = enemies.begin(); it != enemies.end(); ++it) {
-        if (*it && (*it)->isAlive()) {
+    for (std::uint32_t slot : activeSlots) {
+        if (pool[slot].isAlive()) {
             count++;
         }
     }
     return count;
 }
 
-std::vector<Enemy*>& EnemyManager::getEnemies() {
-    return enemies;
+int EnemyManager::getActiveCount() const {
+    return static_cast<int>(activeSlots.size());
+}
+
+Enemy& EnemyManager::getActiveEnemy(int index) {
+    return pool[activeSlots[index]];
+}
+
+const Enemy& EnemyManager::getActiveEnemy(int index) const {
+    return pool[activeSlots[index]];
+}
+
+EnemyHandle EnemyManager::getHandle(int index) const {
+    std::uint32_t slot = activeSlots[index];
+    EnemyHandle handle = { slot, generations[slot] };
+    return handle;
+}
+
+Enemy* EnemyManager::getEnemy(EnemyHandle handle) {
+    if (handle.index >= pool.size() || generations[handle.index] != handle.generation) {
+        return nullptr;
+    }
+    return &pool[handle.index];
+}
+
+int EnemyManager::getCapacity() const {
+    return maxEnemies;
+}
+
+int EnemyManager::getOnScreenCount() const {
+    int count = 0;
+    for (std::uint32_t slot : activeSlots) {
+        count += pool[slot].isOnScreen() ? 1 : 0;
+    }
+    return count;
+}
+
+int EnemyManager::getOffScreenCount() const {
+    return getActiveCount() - getOnScreenCount();
 }
 
 bool EnemyManager::isWaveCleared() const {
-    return enemiesKilledThisWave >= 10 * currentWaveNumber;
+    return enemiesKilledThisWave >= level->getKillQuota(currentWaveNumber);
+}
+
+bool EnemyManager::getIsWaveTransitioning() const {
+    return isWaveTransitioning;
+}
+
+void EnemyManager::saveState(StateWriter& writer) const {
+    writer.write(maxEnemies);
+    for (const Enemy& enemy : pool) {
+        enemy.saveState(writer);
+    }
+    writer.writeVector(generations);
+    writer.writeVector(freeSlots);
+    writer.writeVector(activeSlots);
+    writer.write(spawnTimer);
+    writer.write(waveDelayTimer);
+    writer.write(waveDelay);
+    writer.write(isWaveTransitioning);
+    writer.write(currentWaveNumber);
+    writer.write(enemiesKilledThisWave);
+    writer.write(levelComplete);
+}
+
+bool EnemyManager::loadState(StateReader& reader) {
+    int savedCapacity = 0;
+    reader.read(savedCapacity);
+    if (savedCapacity != maxEnemies) {
+        LOG_ERROR("Saved enemy pool has the wrong capacity", LogField("saved", savedCapacity), LogField("expected", maxEnemies));
+        return false;
+    }
+    for (Enemy& enemy : pool) {
+        enemy.loadState(reader);
+    }
+    reader.readVector(generations);
+    reader.readVector(freeSlots);
+    reader.readVector(activeSlots);
+    reader.read(spawnTimer);
+    reader.read(waveDelayTimer);
+    reader.read(waveDelay);
+    reader.read(isWaveTransitioning);
+    reader.read(currentWaveNumber);
+    reader.read(enemiesKilledThisWave);
+    reader.read(levelComplete);
+    return reader.isGood();
 }
@@ -1,10 +1,18 @@
 #ifndef ENEMY_H
 #define ENEMY_H
 
-#include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp> // Added SFML Audio header
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
 #include <vector>
+#include "Animation.h"
 #include "Hitbox.h"
+#include "GameEvents.h"
+#include "GameRandom.h"
+#include "SimdKernels.h"
+#include "StateStream.h"
+
+struct LevelDefinition;
 
 enum EnemyState {
     IDLE,
@@ -24,31 +32,46 @@ public:
     ~Enemy();
 
     void init(EnemyType type, float startX, float playerY, bool spawnOnRight);
-    void loadTextures();
-    void initSprite();
-    void update(float deltaTime, const sf::Vector2f& playerPosition);
-    void draw(sf::RenderWindow& window);
-
-    void takeDamage(float damage);
+    // Only enemies whose sprite overlaps animatedArea advance their
+    // animation every tick, the others bank the time until they are back
+    void update(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& animatedArea);
+    // Same as calling update on each, with the distance checks done a batch
+    // at a time by classifyEnemyRanges
+    static void updateBatch(Enemy* const* enemies, int count, float deltaTime, const sf::Vector2f& playerPosition,
+                            const sf::FloatRect& animatedArea);
+
+    void takeDamage(float damage, GameEvents& events);
     bool isAlive() const;
     bool canBeRemoved() const;
     sf::Vector2f getPosition() const;
-    sf::FloatRect getBounds() const;
+    sf::Vector2f getPreviousPosition() const; // Position at the start of the last tick, for interpolation
     float getAttackDamage() const;
-    Hitbox* getHitbox() const;
+    const Hitbox& getHitbox() const;
     bool isAttacking() const;
+    // Inside animatedArea during the last update
+    bool isOnScreen() const;
+    // World space rectangle of the untrimmed animation cell
+    sf::FloatRect getSpriteBounds() const;
+
+    // State read by the renderer
+    EnemyType getType() const;
+    EnemyState getState() const;
+    AnimationClipId getAnimation() const;
+    int getCurrentFrame() const;
+    bool isFacingRight() const;
+
+    // Replay keyframes
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
 
 private:
     EnemyType enemyType; // Add enemy type member variable
 
-    void updateState(const sf::Vector2f& playerPosition);
-    void updateAnimation(float deltaTime);
-
-    sf::Sprite sprite;
-    sf::Texture idleTexture;
-    sf::Texture walkTexture;
-    sf::Texture attackTexture;
-    sf::Texture deadTexture;
+    // The rest of update once the range to the player is known
+    void update(EnemyRange range, float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& animatedArea);
+    void updateState(EnemyRange range);
+    // Switch state and its clip; the clip only restarts when it changes
+    void setState(EnemyState state);
 
     EnemyState currentState;
     bool facingRight;
@@ -58,12 +81,9 @@ private:
     float attackRange;
     float detectionRange;
 
-    int frameWidth;
-    int frameHeight;
-    int currentFrame;
-    int totalFrames;
-    float animationTimer;
-    float frameDuration;
+    AnimationPlayer animation;
+    float suspendedTime; // Animation time not yet played while off screen
+    bool onScreen;
 
     float attackCooldown;
     float attackTimer;
@@ -72,45 +92,88 @@ private:
     float deathRemoveTimer;
     float deathRemoveDelay; // e.g., 0.5 seconds
     sf::Vector2f position;
+    sf::Vector2f previousPosition; // Position at the start of the last tick, for interpolation
 
-    sf::SoundBuffer deathSoundBuffer; // Added death sound buffer
-    sf::Sound deathSound; // Added death sound
+    Hitbox hitbox; // Lives inside the enemy, no separate allocation
+};
 
-    Hitbox* hitbox;
+// Stable reference to a pooled enemy. Goes stale once the enemy is removed.
+struct EnemyHandle {
+    std::uint32_t index;      // Slot in the pool
+    std::uint32_t generation; // Bumped every time the slot is freed
 };
 
 class EnemyManager {
 public:
-    EnemyManager();
+    EnemyManager(int maxEnemies = 20);
     ~EnemyManager();
 
+    // Start wave 1 of a level (the default endless level without one). The
+    // level has to outlive the manager.
     void init();
-    void update(float deltaTime, const sf::Vector2f& playerPosition);
-    void render(sf::RenderWindow& window);
-
-    void increaseWave();
+    void init(const LevelDefinition& level);
+    // Like init, but opens with the wave banner and its delay
+    void startLevel(const LevelDefinition& level);
+    // Swap the definition without touching progress, after loadState
+    void setLevel(const LevelDefinition& level);
+    const LevelDefinition& getLevel() const;
+    // Last wave of a level that ends was cleared, nothing spawns any more
+    bool isLevelComplete() const;
+
+    // Two phases: every enemy updates in parallel (updateEnemies), then
+    // spawning, removal and wave progress are applied serially. New enemies
+    // walk in from just outside view, the camera's visible rectangle.
+    void update(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& view, GameRandom& random,
+                GameEvents& events);
+    // Parallel phase on the JobSystem. Enemies only write their own state, so
+    // the result does not depend on the number of threads.
+    void updateEnemies(float deltaTime, const sf::Vector2f& playerPosition, const sf::FloatRect& animatedArea);
+
+    void increaseWave(GameEvents& events);
     int getCurrentWave() const;
     int getRemainingEnemies() const;
-    std::vector<Enemy*>& getEnemies();
     bool isWaveCleared() const;
-
-private:
-    void spawnEnemy(const sf::Vector2f& playerPosition);
+    bool getIsWaveTransitioning() const; // "Wave N" banner is showing, nothing spawns
+
+    // Live enemies are indexed [0, getActiveCount()) in iteration order
+    int getActiveCount() const;
+    Enemy& getActiveEnemy(int index);
+    const Enemy& getActiveEnemy(int index) const;
+    EnemyHandle getHandle(int index) const;
+    Enemy* getEnemy(EnemyHandle handle); // nullptr if the handle is stale
+    int getCapacity() const;
+    // Live enemies inside and outside the animated area during the last update
+    int getOnScreenCount() const;
+    int getOffScreenCount() const;
+
+    // Place an enemy in a free pool slot, nullptr when the pool is full
+    Enemy* spawn(EnemyType type, float startX, float playerY, bool spawnOnRight);
+    // Recycle enemies whose death animation finished. Called by update.
     void removeDeadEnemies();
 
-    std::vector<Enemy*> enemies;
+    // Replay keyframes, the capacity has to match the one that was saved
+    void saveState(StateWriter& writer) const;
+    bool loadState(StateReader& reader);
+
+private:
+    void spawnEnemy(const sf::Vector2f& playerPosition, const sf::FloatRect& view, GameRandom& random);
+    void killAll(GameEvents& events);
 
-    sf::Text waveTransitionText;
-    sf::Font waveFont;
+    // Fixed-capacity pool; enemies never move, so pointers and handles stay valid
+    std::vector<Enemy> pool;
+    std::vector<std::uint32_t> generations; // Per pool slot
+    std::vector<std::uint32_t> freeSlots;   // Unused pool slots
+    std::vector<std::uint32_t> activeSlots; // Dense list of live slots, swap-and-pop removal
 
+    const LevelDefinition* level; // Wave pacing and spawn zones
     float spawnTimer;
-    float spawnInterval;
     int maxEnemies;
     float waveDelayTimer;
     float waveDelay;
     bool isWaveTransitioning; 
     int currentWaveNumber;
     int enemiesKilledThisWave;
+    bool levelComplete;
 };
 
 #endif // ENEMY_H
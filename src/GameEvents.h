@@ -0,0 +1,59 @@
+#ifndef GAMEEVENTS_H
+#define GAMEEVENTS_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+enum GameSound {
+    SOUND_SHOOT,
+    SOUND_RELOAD,
+    SOUND_PLAYER_DEATH,
+    SOUND_ZOMBIE_DEATH,
+    SOUND_COUNT
+};
+
+struct SoundEvent {
+    GameSound sound;
+    sf::Vector2f position; // World position of the source
+};
+
+// Particle bursts, see ParticleSystem
+enum GameEffect {
+    EFFECT_MUZZLE_FLASH,
+    EFFECT_BLOOD,       // Bullet hit
+    EFFECT_BLOOD_BURST, // Enemy death
+    EFFECT_EXPLOSION,   // Fireball, one particle playing the strip
+    EFFECT_DEBRIS,      // Smoke thrown out of an explosion
+    EFFECT_COUNT
+};
+
+struct EffectEvent {
+    GameEffect effect;
+    sf::Vector2f position;
+    bool facingRight; // Directed effects spray this way
+};
+
+// Things the simulation wants the presentation layer to react to. Filled
+// during a tick and cleared at the start of the next one, so the core never
+// needs an audio device.
+struct GameEvents {
+    std::vector<SoundEvent> sounds;
+    std::vector<EffectEvent> effects;
+
+    void playSound(GameSound sound, const sf::Vector2f& position) {
+        SoundEvent event = { sound, position };
+        sounds.push_back(event);
+    }
+
+    void spawnEffect(GameEffect effect, const sf::Vector2f& position, bool facingRight) {
+        EffectEvent event = { effect, position, facingRight };
+        effects.push_back(event);
+    }
+
+    void clear() {
+        sounds.clear();
+        effects.clear();
+    }
+};
+
+#endif // GAMEEVENTS_H
@@ -0,0 +1,42 @@
+#ifndef GAMEINPUT_H
+#define GAMEINPUT_H
+
+#include <cstdint>
+
+// Everything the simulation reads from the player in one tick. The window
+// build fills it from the keyboard, headless runs synthesize it, so the
+// gameplay code never talks to an input device.
+struct InputState {
+    bool moveLeft;
+    bool moveRight;
+    bool shoot;
+    bool reload;
+    bool throwGrenade;
+
+    InputState() :
+        moveLeft(false),
+        moveRight(false),
+        shoot(false),
+        reload(false),
+        throwGrenade(false)
+    {
+    }
+
+    // One bit per button, the per-tick record of a replay
+    std::uint8_t toBits() const {
+        return static_cast<std::uint8_t>((moveLeft ? 1 : 0) | (moveRight ? 2 : 0) | (shoot ? 4 : 0) | (reload ? 8 : 0) |
+                                         (throwGrenade ? 16 : 0));
+    }
+
+    static InputState fromBits(std::uint8_t bits) {
+        InputState input;
+        input.moveLeft = (bits & 1) != 0;
+        input.moveRight = (bits & 2) != 0;
+        input.shoot = (bits & 4) != 0;
+        input.reload = (bits & 8) != 0;
+        input.throwGrenade = (bits & 16) != 0;
+        return input;
+    }
+};
+
+#endif // GAMEINPUT_H
@@ -0,0 +1,50 @@
+#include "GameRandom.h"
+
+namespace {
+
+const std::uint64_t MULTIPLIER = 6364136223846793005ULL;
+const std::uint64_t INCREMENT = 1442695040888963407ULL; // Any odd constant
+
+} // namespace
+
+GameRandom::GameRandom(std::uint64_t seed) :
+    state(0)
+{
+    this->seed(seed);
+}
+
+void GameRandom::seed(std::uint64_t seed) {
+    state = 0;
+    next();
+    state += seed;
+    next();
+}
+
+std::uint32_t GameRandom::next() {
+    std::uint64_t old = state;
+    state = old * MULTIPLIER + INCREMENT;
+    // Xorshift the high bits down, then rotate by the top five bits
+    std::uint32_t xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+    std::uint32_t rotation = static_cast<std::uint32_t>(old >> 59u);
+    return (xorshifted >> rotation) | (xorshifted << ((32u - rotation) & 31u));
+}
+
+int GameRandom::nextInt(int min, int max) {
+    // The modulo bias is far below anything gameplay can notice
+    std::uint32_t range = static_cast<std::uint32_t>(max - min) + 1u;
+    return min + static_cast<int>(next() % range);
+}
+
+float GameRandom::nextFloat(float min, float max) {
+    // 24 random bits fill the float mantissa exactly
+    float unit = (next() >> 8) * (1.0f / 16777216.0f);
+    return min + unit * (max - min);
+}
+
+std::uint64_t GameRandom::getState() const {
+    return state;
+}
+
+void GameRandom::setState(std::uint64_t state) {
+    this->state = state;
+}
@@ -0,0 +1,29 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <cstdint>
+
+// The one random number generator of the simulation (PCG32). Seeded once
+// per run, cheap to copy and its whole state is a single integer, so a
+// replay keyframe can capture it. Results are the same on every platform,
+// unlike the std:: distributions.
+class GameRandom {
+public:
+    explicit GameRandom(std::uint64_t seed = 0);
+
+    void seed(std::uint64_t seed);
+
+    std::uint32_t next();
+    // Uniform integer in [min, max]
+    int nextInt(int min, int max);
+    // Uniform float in [min, max)
+    float nextFloat(float min, float max);
+
+    std::uint64_t getState() const;
+    void setState(std::uint64_t state);
+
+private:
+    std::uint64_t state;
+};
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,168 @@
+#include "GameRenderer.h"
+#include "Log.h"
+#include <algorithm>
+
+namespace {
+
+const float SPRITE_SCALE = 3.0f;
+const float GRENADE_SCALE = 1.5f;
+// Strip every particle and grenade is drawn from, see ParticleSystem
+const char* const EFFECT_CHARACTER = "Player";
+const char* const EFFECT_CLIP = "Explosion";
+
+sf::Vector2f interpolate(const sf::Vector2f& previous, const sf::Vector2f& current, float alpha) {
+    return sf::Vector2f(previous.x + (current.x - previous.x) * alpha, previous.y + (current.y - previous.y) * alpha);
+}
+
+sf::FloatRect interpolate(const sf::FloatRect& previous, const sf::FloatRect& current, float alpha) {
+    sf::Vector2f position = interpolate(sf::Vector2f(previous.left, previous.top), sf::Vector2f(current.left, current.top), alpha);
+    return sf::FloatRect(position.x, position.y, current.width, current.height);
+}
+
+} // namespace
+
+GameRenderer::GameRenderer() :
+    effectClip(nullptr),
+    visibleEnemies(0),
+    culledEnemies(0)
+{
+    for (int i = 0; i < CLIP_COUNT; i++) {
+        clips[i] = nullptr;
+    }
+}
+
+void GameRenderer::init() {
+    SpriteAtlas& atlas = SpriteAtlas::instance();
+
+    // Decode every animation up front so spawning never touches the disk
+    for (int i = 0; i < CLIP_COUNT; i++) {
+        const AnimationClip& clip = getAnimationClip(static_cast<AnimationClipId>(i));
+        clips[i] = &atlas.getClip(clip.character, clip.name);
+        if (clips[i]->frames.empty()) {
+            LOG_WARN("Missing animation", LogField("character", clip.character), LogField("clip", clip.name));
+        }
+        else if (static_cast<int>(clips[i]->frames.size()) != clip.frameCount) {
+            LOG_WARN("Animation frame count differs from the atlas", LogField("character", clip.character),
+                     LogField("clip", clip.name), LogField("frames", clip.frameCount),
+                     LogField("atlas_frames", clips[i]->frames.size()));
+        }
+    }
+
+    effectClip = &atlas.getClip(EFFECT_CHARACTER, EFFECT_CLIP);
+    effectPages.clear();
+    for (const AtlasFrame& frame : effectClip->frames) {
+        if (frame.texture && std::find(effectPages.begin(), effectPages.end(), frame.texture) == effectPages.end()) {
+            effectPages.push_back(frame.texture);
+        }
+    }
+    if (effectPages.empty()) {
+        LOG_WARN("Missing particle strip", LogField("character", EFFECT_CHARACTER), LogField("clip", EFFECT_CLIP));
+    }
+}
+
+void GameRenderer::getStripPaths(std::vector<std::string>& paths) {
+    for (int i = 0; i < CLIP_COUNT; i++) {
+        const AnimationClip& clip = getAnimationClip(static_cast<AnimationClipId>(i));
+        paths.push_back(SpriteAtlas::getStripPath(clip.character, clip.name));
+    }
+    paths.push_back(SpriteAtlas::getStripPath(EFFECT_CHARACTER, EFFECT_CLIP));
+}
+
+void GameRenderer::render(RenderQueue& queue, const RenderSnapshot& snapshot, float alpha, const sf::FloatRect& view) {
+    renderPlayer(queue, snapshot.player, alpha);
+    renderBullets(queue, snapshot.bullets, alpha);
+    renderGrenades(queue, snapshot.grenades, alpha);
+    renderEnemies(queue, snapshot.enemies, alpha, view);
+}
+
+void GameRenderer::renderParticles(RenderQueue& queue, const ParticleSystem& particles) {
+    // Sized once for full pools, so building never touches the allocator
+    std::size_t capacity = static_cast<std::size_t>(particles.getCapacity()) * 4;
+    if (particleVertices.size() < capacity) {
+        particleVertices.resize(capacity);
+    }
+    // Each page writes behind the previous one, only a particle's frame decides its page
+    sf::Vertex* out = particleVertices.data();
+    for (const sf::Texture* page : effectPages) {
+        std::size_t count = particles.buildVertices(*effectClip, page, out);
+        queue.submitVertices(LAYER_EFFECTS, page, out, count, sf::Quads);
+        out += count;
+    }
+}
+
+int GameRenderer::getVisibleEnemyCount() const {
+    return visibleEnemies;
+}
+
+int GameRenderer::getCulledEnemyCount() const {
+    return culledEnemies;
+}
+
+void GameRenderer::renderPlayer(RenderQueue& queue, const PlayerSnapshot& player, float alpha) {
+    const AtlasClip* clip = clips[player.clip];
+    if (!clip) {
+        return;
+    }
+    // Origin at the center of the 128x128 cell, half transparent while flashing
+    const float pivot = SpriteAtlas::FRAME_SIZE / 2.0f;
+    sf::Color color(255, 255, 255, player.flashing ? 128 : 255);
+    queue.submit(LAYER_PLAYER, clip->getFrame(player.frame), interpolate(player.previousPosition, player.position, alpha),
+                 sf::Vector2f(pivot, pivot), SPRITE_SCALE, !player.facingRight, color);
+}
+
+void GameRenderer::renderBullets(RenderQueue& queue, const std::vector<BulletSnapshot>& bullets, float alpha) {
+    const sf::Color color = sf::Color::Yellow;
+    bulletVertices.clear();
+    for (const BulletSnapshot& bullet : bullets) {
+        sf::FloatRect bounds = interpolate(bullet.previousBounds, bullet.bounds, alpha);
+        sf::Vector2f topLeft(bounds.left, bounds.top);
+        sf::Vector2f topRight(bounds.left + bounds.width, bounds.top);
+        sf::Vector2f bottomRight(bounds.left + bounds.width, bounds.top + bounds.height);
+        sf::Vector2f bottomLeft(bounds.left, bounds.top + bounds.height);
+        bulletVertices.push_back(sf::Vertex(topLeft, color));
+        bulletVertices.push_back(sf::Vertex(topRight, color));
+        bulletVertices.push_back(sf::Vertex(bottomRight, color));
+        bulletVertices.push_back(sf::Vertex(topLeft, color));
+        bulletVertices.push_back(sf::Vertex(bottomRight, color));
+        bulletVertices.push_back(sf::Vertex(bottomLeft, color));
+    }
+    // Every bullet in a single draw
+    queue.submitVertices(LAYER_BULLETS, nullptr, bulletVertices.data(), bulletVertices.size());
+}
+
+void GameRenderer::renderGrenades(RenderQueue& queue, const std::vector<GrenadeSnapshot>& grenades, float alpha) {
+    if (!effectClip || effectClip->frames.empty()) {
+        return;
+    }
+    // The strip opens with the grenade itself, resting on the bottom of the cell
+    const sf::Vector2f pivot(SpriteAtlas::FRAME_SIZE / 2.0f, static_cast<float>(SpriteAtlas::FRAME_SIZE));
+    for (const GrenadeSnapshot& grenade : grenades) {
+        queue.submit(LAYER_BULLETS, effectClip->getFrame(grenade.frame), interpolate(grenade.previousPosition, grenade.position, alpha),
+                     pivot, GRENADE_SCALE, false);
+    }
+}
+
+void GameRenderer::renderEnemies(RenderQueue& queue, const std::vector<EnemySnapshot>& enemies, float alpha,
+                                 const sf::FloatRect& view) {
+    // Feet stay on the center bottom of the untrimmed cell
+    const sf::Vector2f pivot(SpriteAtlas::FRAME_SIZE / 2.0f, static_cast<float>(SpriteAtlas::FRAME_SIZE));
+    const float size = SpriteAtlas::FRAME_SIZE * SPRITE_SCALE;
+    visibleEnemies = 0;
+    culledEnemies = 0;
+    for (const EnemySnapshot& enemy : enemies) {
+        const AtlasClip* clip = clips[enemy.clip];
+        if (!clip) {
+            continue;
+        }
+        // Skipped once the whole cell is outside the view. Everything inside
+        // was animated by the simulation, see Enemy::update.
+        sf::Vector2f position = interpolate(enemy.previousPosition, enemy.position, alpha);
+        if (position.x + size / 2.0f <= view.left || position.x - size / 2.0f >= view.left + view.width ||
+            position.y <= view.top || position.y - size >= view.top + view.height) {
+            culledEnemies++;
+            continue;
+        }
+        visibleEnemies++;
+        queue.submit(LAYER_ENEMIES, clip->getFrame(enemy.frame), position, pivot, SPRITE_SCALE, !enemy.facingRight);
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef GAMERENDERER_H
+#define GAMERENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "ParticleSystem.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
+#include "SpriteAtlas.h"
+
+// Draws a snapshot of the simulation state. Resolves the atlas frames of
+// every clip in the animation table once, so the gameplay classes only keep
+// a clip id and a frame index.
+class GameRenderer {
+public:
+    GameRenderer();
+
+    // Resolve the atlas frames of every animation clip
+    void init();
+    // Strip files init() falls back to when there is no baked atlas
+    static void getStripPaths(std::vector<std::string>& paths);
+    // alpha blends between the previous and the current tick. Enemies outside
+    // view are not submitted.
+    void render(RenderQueue& queue, const RenderSnapshot& snapshot, float alpha, const sf::FloatRect& view);
+
+    // Every live particle, one batch per atlas page of the effect strip
+    void renderParticles(RenderQueue& queue, const ParticleSystem& particles);
+
+    // Enemies submitted and skipped by the last render
+    int getVisibleEnemyCount() const;
+    int getCulledEnemyCount() const;
+
+private:
+    void renderPlayer(RenderQueue& queue, const PlayerSnapshot& player, float alpha);
+    void renderBullets(RenderQueue& queue, const std::vector<BulletSnapshot>& bullets, float alpha);
+    void renderGrenades(RenderQueue& queue, const std::vector<GrenadeSnapshot>& grenades, float alpha);
+    void renderEnemies(RenderQueue& queue, const std::vector<EnemySnapshot>& enemies, float alpha, const sf::FloatRect& view);
+
+    const AtlasClip* clips[CLIP_COUNT];
+    const AtlasClip* effectClip;
+    std::vector<const sf::Texture*> effectPages;
+    std::vector<sf::Vertex> particleVertices; // Room for every particle, allocated once
+    int visibleEnemies;
+    int culledEnemies;
+    std::vector<sf::Vertex> bulletVertices; // Reused every frame for the single draw
+};
+
+#endif // GAMERENDERER_H
@@ -0,0 +1,226 @@
+#include "GameWorld.h"
+#include "Profiler.h"
+
+GameWorld::GameWorld() :
+    bulletManager(20),
+    campaign(&Campaign::getDefault()),
+    levelIndex(0),
+    canShoot(true),
+    canReload(true),
+    canThrow(true),
+    tickCount(0)
+{
+}
+
+void GameWorld::setCampaign(const Campaign& campaign) {
+    this->campaign = &campaign;
+}
+
+void GameWorld::init(std::uint64_t seed) {
+    random.seed(seed);
+    player.init();
+    levelIndex = 0;
+    enemyManager.init(campaign->getLevel(levelIndex));
+    enterLevel();
+    events.clear();
+    canShoot = true;
+    canReload = true;
+    canThrow = true;
+    tickCount = 0;
+}
+
+void GameWorld::tick(const InputState& input, float deltaTime) {
+    events.clear();
+
+    {
+        PROFILE_ZONE("Player::update");
+        player.update(deltaTime, input, events);
+    }
+    camera.follow(player.getPosition().x);
+    sf::FloatRect view = camera.getView();
+
+    // Handle shooting
+    if (!input.shoot) {
+        canShoot = true;
+    }
+    if (input.shoot && canShoot && !player.getIsReloading() && !player.getIsThrowing()) {
+        // Get player position and direction
+        float bulletX = player.isFacingRight() ?
+            player.getPosition().x + player.getSize().x - 10.0f :
+            player.getPosition().x - player.getSize().x + 10.0f;
+        float bulletY = player.getPosition().y + player.getSize().y / 1.5f;
+
+        bulletManager.fireBullet(bulletX, bulletY, player.isFacingRight());
+        events.spawnEffect(EFFECT_MUZZLE_FLASH, sf::Vector2f(bulletX, bulletY), player.isFacingRight());
+        canShoot = false;
+    }
+
+    // Handle reload
+    if (!input.reload) {
+        canReload = true;
+    }
+    if (input.reload && canReload) {
+        bulletManager.reload();
+        canReload = false;
+    }
+
+    // Handle grenades, thrown once the throw animation gets the arm forward
+    if (!input.throwGrenade) {
+        canThrow = true;
+    }
+    if (input.throwGrenade && canThrow && grenadeManager.getRemainingGrenades() > 0 && player.startThrow()) {
+        canThrow = false;
+    }
+    if (player.isReleasingGrenade()) {
+        sf::FloatRect feet = player.getHitbox().getBounds();
+        grenadeManager.throwGrenade(player.getGrenadeOrigin(), player.isFacingRight(), feet.top + feet.height);
+    }
+
+    // Update bullets, grenades and enemies
+    {
+        PROFILE_ZONE("BulletManager::update");
+        bulletManager.update(deltaTime, view.left, view.left + view.width);
+    }
+    grenadeManager.update(deltaTime);
+    {
+        PROFILE_ZONE("EnemyManager::update");
+        enemyManager.update(deltaTime, player.getPosition(), view, random, events);
+    }
+
+    // Check for collisions
+    {
+        PROFILE_ZONE("Collision::broadphase");
+        collisionSystem.update(enemyManager);
+    }
+    {
+        PROFILE_ZONE("Collision::bullets");
+        collisionSystem.checkBulletEnemyCollisions(bulletManager, enemyManager, events);
+    }
+    {
+        PROFILE_ZONE("Collision::player");
+        collisionSystem.checkPlayerEnemyCollisions(player, enemyManager);
+    }
+    if (!grenadeManager.getExplosions().empty()) {
+        PROFILE_ZONE("Collision::explosions");
+        for (const sf::Vector2f& explosion : grenadeManager.getExplosions()) {
+            events.spawnEffect(EFFECT_EXPLOSION, explosion, true);
+            events.spawnEffect(EFFECT_DEBRIS, explosion, true);
+            collisionSystem.applyRadiusDamage(explosion, GrenadeManager::EXPLOSION_RADIUS,
+                                              GrenadeManager::EXPLOSION_DAMAGE, enemyManager, events);
+        }
+    }
+
+    // On to the next stage once the last zombies finished dying, it opens
+    // with the wave banner
+    if (enemyManager.isLevelComplete() && enemyManager.getActiveCount() == 0 &&
+        levelIndex + 1 < campaign->getLevelCount()) {
+        levelIndex++;
+        enemyManager.startLevel(campaign->getLevel(levelIndex));
+        enterLevel();
+    }
+
+    tickCount++;
+}
+
+void GameWorld::enterLevel() {
+    // The player keeps their position, moved in if the new level is narrower
+    float width = campaign->getLevel(levelIndex).width;
+    player.setWorldWidth(width);
+    grenadeManager.restock();
+    camera.init(width, player.getPosition().x);
+}
+
+bool GameWorld::isGameOver() const {
+    return (!player.isAlive() && player.isDeathAnimationComplete()) || isCampaignComplete();
+}
+
+bool GameWorld::isCampaignComplete() const {
+    return enemyManager.isLevelComplete() && levelIndex + 1 >= campaign->getLevelCount();
+}
+
+unsigned long GameWorld::getTickCount() const {
+    return tickCount;
+}
+
+int GameWorld::getLevelIndex() const {
+    return levelIndex;
+}
+
+Player& GameWorld::getPlayer() {
+    return player;
+}
+
+const Player& GameWorld::getPlayer() const {
+    return player;
+}
+
+BulletManager& GameWorld::getBullets() {
+    return bulletManager;
+}
+
+const BulletManager& GameWorld::getBullets() const {
+    return bulletManager;
+}
+
+const GrenadeManager& GameWorld::getGrenades() const {
+    return grenadeManager;
+}
+
+EnemyManager& GameWorld::getEnemies() {
+    return enemyManager;
+}
+
+const EnemyManager& GameWorld::getEnemies() const {
+    return enemyManager;
+}
+
+const CollisionSystem& GameWorld::getCollisions() const {
+    return collisionSystem;
+}
+
+const Camera& GameWorld::getCamera() const {
+    return camera;
+}
+
+const GameEvents& GameWorld::getEvents() const {
+    return events;
+}
+
+void GameWorld::saveState(StateWriter& writer) const {
+    writer.write(tickCount);
+    writer.write(random.getState());
+    writer.write(canShoot);
+    writer.write(canReload);
+    writer.write(canThrow);
+    writer.write(levelIndex);
+    camera.saveState(writer);
+    player.saveState(writer);
+    bulletManager.saveState(writer);
+    grenadeManager.saveState(writer);
+    enemyManager.saveState(writer);
+}
+
+bool GameWorld::loadState(StateReader& reader) {
+    std::uint64_t randomState = 0;
+    reader.read(tickCount);
+    reader.read(randomState);
+    reader.read(canShoot);
+    reader.read(canReload);
+    reader.read(canThrow);
+    reader.read(levelIndex);
+    random.setState(randomState);
+    if (levelIndex < 0 || levelIndex >= campaign->getLevelCount()) {
+        return false; // Saved with another campaign
+    }
+    enemyManager.setLevel(campaign->getLevel(levelIndex));
+    camera.loadState(reader);
+    player.loadState(reader);
+    bulletManager.loadState(reader);
+    grenadeManager.loadState(reader);
+    if (!enemyManager.loadState(reader) || !reader.isGood()) {
+        return false;
+    }
+    // The broadphase and events are rebuilt by the next tick
+    events.clear();
+    return true;
+}
@@ -0,0 +1,80 @@
+#ifndef GAMEWORLD_H
+#define GAMEWORLD_H
+
+#include "GameInput.h"
+#include "GameEvents.h"
+#include "GameRandom.h"
+#include "StateStream.h"
+#include "Player.h"
+#include "Bullet.h"
+#include "Grenade.h"
+#include "Enemy.h"
+#include "Collision.h"
+#include "Level.h"
+#include "Camera.h"
+
+// The whole simulation: player, bullets, grenades, enemies and collisions, advanced
+// one fixed tick at a time from an InputState. Nothing in here opens a
+// window, loads a texture or touches an audio device; sounds are reported
+// through GameEvents and drawing is done by GameRenderer. The core sources
+// (GameWorld, Player, Bullet, Grenade, Enemy, Collision, Camera) only use SFML's
+// header-only vector and rect types, so they build and run on machines
+// without a display.
+class GameWorld {
+public:
+    GameWorld();
+
+    // Levels to play, the default endless level otherwise. Set before init
+    // or loadState; the campaign has to outlive the world.
+    void setCampaign(const Campaign& campaign);
+    // Every run with the same seed, campaign and inputs plays out identically
+    void init(std::uint64_t seed);
+    void tick(const InputState& input, float deltaTime);
+
+    // Player died and the death animation finished playing, or the last
+    // level was cleared
+    bool isGameOver() const;
+    bool isCampaignComplete() const;
+    unsigned long getTickCount() const;
+    int getLevelIndex() const;
+
+    Player& getPlayer();
+    const Player& getPlayer() const;
+    BulletManager& getBullets();
+    const BulletManager& getBullets() const;
+    const GrenadeManager& getGrenades() const;
+    EnemyManager& getEnemies();
+    const EnemyManager& getEnemies() const;
+    const CollisionSystem& getCollisions() const;
+    const Camera& getCamera() const;
+    // Events raised by the last tick
+    const GameEvents& getEvents() const;
+
+    // Full simulation state, for replay keyframes
+    void saveState(StateWriter& writer) const;
+    bool loadState(StateReader& reader);
+
+private:
+    // Fit the player and camera to the current level's width
+    void enterLevel();
+
+    Player player;
+    BulletManager bulletManager;
+    GrenadeManager grenadeManager;
+    EnemyManager enemyManager;
+    CollisionSystem collisionSystem;
+    Camera camera;
+    GameEvents events;
+    GameRandom random;
+    const Campaign* campaign;
+    int levelIndex;
+
+    // Shooting, reloading and throwing need the key released before they
+    // trigger again
+    bool canShoot;
+    bool canReload;
+    bool canThrow;
+    unsigned long tickCount;
+};
+
+#endif // GAMEWORLD_H
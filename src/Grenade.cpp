@@ -0,0 +1,119 @@
+#include "Grenade.h"
+
+namespace {
+
+// Lands about 550 pixels ahead of the player once it stops bouncing
+const float THROW_SPEED_X = 360.0f;
+const float THROW_SPEED_Y = -480.0f; // Up and over the nearest zombies
+const float GRAVITY = 1400.0f;
+const float BOUNCE = 0.35f;   // Vertical speed kept by a bounce
+const float FRICTION = 0.6f;  // Horizontal speed kept by a bounce
+const float REST_SPEED = 60.0f; // Bounces slower than this stop the grenade
+const float FUSE_TIME = 1.5f;
+
+} // namespace
+
+const float GrenadeManager::EXPLOSION_RADIUS = 220.0f;
+const float GrenadeManager::EXPLOSION_DAMAGE = 80.0f;
+
+GrenadeManager::GrenadeManager(int maxGrenades) :
+    maxGrenades(maxGrenades),
+    remainingGrenades(maxGrenades)
+{
+}
+
+void GrenadeManager::restock() {
+    grenades.clear();
+    explosions.clear();
+    remainingGrenades = maxGrenades;
+}
+
+bool GrenadeManager::throwGrenade(const sf::Vector2f& position, bool facingRight, float groundY) {
+    if (remainingGrenades <= 0) {
+        return false;
+    }
+    remainingGrenades--;
+
+    Grenade grenade;
+    grenade.position = position;
+    grenade.previousPosition = position;
+    grenade.velocity = sf::Vector2f(facingRight ? THROW_SPEED_X : -THROW_SPEED_X, THROW_SPEED_Y);
+    grenade.groundY = groundY;
+    grenade.fuse = FUSE_TIME;
+    grenades.push_back(grenade);
+    return true;
+}
+
+void GrenadeManager::update(float deltaTime) {
+    explosions.clear();
+
+    for (std::size_t i = 0; i < grenades.size(); /* no increment */) {
+        Grenade& grenade = grenades[i];
+        grenade.previousPosition = grenade.position;
+
+        grenade.velocity.y += GRAVITY * deltaTime;
+        grenade.position += grenade.velocity * deltaTime;
+
+        // Bounce off the ground until it settles
+        if (grenade.position.y >= grenade.groundY) {
+            grenade.position.y = grenade.groundY;
+            if (grenade.velocity.y > REST_SPEED) {
+                grenade.velocity.y = -grenade.velocity.y * BOUNCE;
+                grenade.velocity.x *= FRICTION;
+            }
+            else {
+                grenade.velocity = sf::Vector2f(0.0f, 0.0f);
+            }
+        }
+
+        grenade.fuse -= deltaTime;
+        if (grenade.fuse > 0.0f) {
+            ++i;
+            continue;
+        }
+        explosions.push_back(grenade.position);
+        grenades[i] = grenades.back();
+        grenades.pop_back();
+    }
+}
+
+int GrenadeManager::getRemainingGrenades() const {
+    return remainingGrenades;
+}
+
+int GrenadeManager::getMaxGrenades() const {
+    return maxGrenades;
+}
+
+int GrenadeManager::getActiveCount() const {
+    return static_cast<int>(grenades.size());
+}
+
+sf::Vector2f GrenadeManager::getPosition(int index) const {
+    return grenades[index].position;
+}
+
+sf::Vector2f GrenadeManager::getPreviousPosition(int index) const {
+    return grenades[index].previousPosition;
+}
+
+float GrenadeManager::getFuse(int index) const {
+    return grenades[index].fuse;
+}
+
+const std::vector<sf::Vector2f>& GrenadeManager::getExplosions() const {
+    return explosions;
+}
+
+void GrenadeManager::saveState(StateWriter& writer) const {
+    writer.writeVector(grenades);
+    writer.write(maxGrenades);
+    writer.write(remainingGrenades);
+}
+
+void GrenadeManager::loadState(StateReader& reader) {
+    reader.readVector(grenades);
+    reader.read(maxGrenades);
+    reader.read(remainingGrenades);
+    explosions.clear();
+}
@@ -0,0 +1,56 @@
+#ifndef GRENADE_H
+#define GRENADE_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "StateStream.h"
+
+// Thrown grenades: each flies on a ballistic arc, bounces along the ground
+// and goes off when its fuse runs out. Explosions are only reported here;
+// the damage is dealt through CollisionSystem::applyRadiusDamage.
+class GrenadeManager {
+public:
+    static const float EXPLOSION_RADIUS;
+    static const float EXPLOSION_DAMAGE; // At the center, falling off to nothing at the radius
+
+    GrenadeManager(int maxGrenades = 3);
+
+    // Drop every grenade in flight and refill the stock
+    void restock();
+    // Throw from position towards the facing side, landing on groundY.
+    // Returns false when the stock is empty.
+    bool throwGrenade(const sf::Vector2f& position, bool facingRight, float groundY);
+    void update(float deltaTime);
+
+    int getRemainingGrenades() const;
+    int getMaxGrenades() const;
+
+    // Per grenade access for the renderer
+    int getActiveCount() const;
+    sf::Vector2f getPosition(int index) const;
+    sf::Vector2f getPreviousPosition(int index) const;
+    float getFuse(int index) const; // Seconds left
+
+    // Where grenades went off during the last update
+    const std::vector<sf::Vector2f>& getExplosions() const;
+
+    // Replay keyframes
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
+
+private:
+    struct Grenade {
+        sf::Vector2f position;
+        sf::Vector2f previousPosition; // Before the last update, for interpolation
+        sf::Vector2f velocity;
+        float groundY;
+        float fuse;
+    };
+
+    std::vector<Grenade> grenades;
+    std::vector<sf::Vector2f> explosions;
+    int maxGrenades;
+    int remainingGrenades;
+};
+
+#endif // GRENADE_H
@@ -0,0 +1,168 @@
+#include "HeadlessRunner.h"
+#include "GameWorld.h"
+#include "Replay.h"
+#include "Log.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+// Grenades are thrown when this many zombies are around where one lands
+const float GRENADE_RANGE_MIN = 300.0f;
+const float GRENADE_RANGE_MAX = 800.0f;
+const int GRENADE_CROWD = 4;
+
+// Stand-in for the keyboard: turn towards the nearest zombie, tap the
+// trigger every other tick, reload once the magazine is empty and throw a
+// grenade into crowds
+InputState scriptedInput(const GameWorld& world) {
+    InputState input;
+    const Player& player = world.getPlayer();
+    const EnemyManager& enemies = world.getEnemies();
+
+    float nearestDistance = -1.0f;
+    float nearestX = 0.0f;
+    int crowd = 0; // Enemies close enough to be worth a grenade
+    for (int i = 0; i < enemies.getActiveCount(); i++) {
+        const Enemy& enemy = enemies.getActiveEnemy(i);
+        float distance = std::fabs(enemy.getPosition().x - player.getPosition().x);
+        if (enemy.isAlive() && (nearestDistance < 0 || distance < nearestDistance)) {
+            nearestDistance = distance;
+            nearestX = enemy.getPosition().x;
+        }
+        bool ahead = (enemy.getPosition().x > player.getPosition().x) == player.isFacingRight();
+        if (enemy.isAlive() && ahead && distance > GRENADE_RANGE_MIN && distance < GRENADE_RANGE_MAX) {
+            crowd++;
+        }
+    }
+    if (nearestDistance >= 0) {
+        bool targetRight = nearestX > player.getPosition().x;
+        if (targetRight != player.isFacingRight()) {
+            input.moveRight = targetRight;
+            input.moveLeft = !targetRight;
+        }
+    }
+
+    bool pressed = world.getTickCount() % 2 == 0;
+    if (crowd >= GRENADE_CROWD) {
+        input.throwGrenade = pressed;
+    }
+    if (world.getBullets().getRemainingBullets() == 0) {
+        input.reload = pressed;
+    }
+    else {
+        input.shoot = pressed;
+    }
+    return input;
+}
+
+// Hash of the full simulation state, equal runs print equal checksums
+std::uint64_t stateChecksum(const GameWorld& world) {
+    StateWriter writer;
+    world.saveState(writer);
+    std::uint64_t hash = 14695981039346656037ULL; // FNV-1a
+    for (char byte : writer.getData()) {
+        hash = (hash ^ static_cast<unsigned char>(byte)) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace
+
+int runHeadless(const HeadlessOptions& options) {
+    typedef std::chrono::steady_clock Clock;
+
+    Campaign campaign;
+    campaign.load(options.campaignPath);
+    GameWorld world;
+    world.setCampaign(campaign);
+    Replay replay;
+    Replay recording;
+    float tickDuration = options.tickDuration;
+    unsigned long ticks = options.ticks;
+    bool playing = !options.replayPath.empty();
+    bool recordingRun = !options.recordPath.empty();
+
+    if (playing) {
+        if (!replay.load(options.replayPath)) {
+            return 1;
+        }
+        // The replay decides the rate, and by default runs to its end
+        tickDuration = 1.0f / replay.getTickRate();
+        Clock::time_point seekStart = Clock::now();
+        if (!replay.seek(world, static_cast<std::uint32_t>(options.seekTick))) {
+            return 1;
+        }
+        double seekTime = std::chrono::duration<double>(Clock::now() - seekStart).count();
+        LOG_INFO("Replay loaded", LogField("seed", replay.getSeed()), LogField("ticks", replay.getTickCount()),
+                 LogField("seek_tick", world.getTickCount()), LogField("seek_ms", seekTime * 1000.0));
+        unsigned long remaining = replay.getTickCount() - world.getTickCount();
+        if (ticks > remaining) {
+            ticks = remaining;
+        }
+    }
+    else {
+        world.init(options.seed);
+        LOG_INFO("Starting", LogField("seed", options.seed));
+        if (recordingRun) {
+            recording.begin(options.seed, 1.0f / tickDuration);
+        }
+    }
+
+    unsigned long deathTick = 0;
+    bool aliveAtStart = world.getPlayer().isAlive();
+    long long candidatePairs = 0;
+    long long hits = 0;
+    long long explosions = 0;
+    long long onScreenEnemies = 0; // Summed over ticks
+    long long offScreenEnemies = 0;
+    double slowestTick = 0.0;
+
+    Clock::time_point start = Clock::now();
+    for (unsigned long i = 0; i < ticks; i++) {
+        InputState input = playing ? replay.getInput(static_cast<std::uint32_t>(world.getTickCount())) : scriptedInput(world);
+        if (recordingRun && !playing) {
+            recording.record(world, input);
+        }
+
+        Clock::time_point tickStart = Clock::now();
+        world.tick(input, tickDuration);
+        double tickTime = std::chrono::duration<double>(Clock::now() - tickStart).count();
+        if (tickTime > slowestTick) {
+            slowestTick = tickTime;
+        }
+
+        candidatePairs += world.getCollisions().getCandidatePairs();
+        hits += world.getCollisions().getHits();
+        explosions += world.getGrenades().getExplosions().size();
+        onScreenEnemies += world.getEnemies().getOnScreenCount();
+        offScreenEnemies += world.getEnemies().getOffScreenCount();
+        // Keep simulating after the player dies, the zombies still have to be updated
+        if (aliveAtStart && deathTick == 0 && !world.getPlayer().isAlive()) {
+            deathTick = world.getTickCount();
+        }
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    LOG_INFO("Headless run", LogField("ticks", ticks), LogField("simulated_s", ticks * tickDuration),
+             LogField("elapsed_s", elapsed), LogField("ticks_per_s", elapsed > 0 ? ticks / elapsed : 0.0));
+    LOG_INFO("Tick time", LogField("average_us", ticks > 0 ? elapsed / ticks * 1e6 : 0.0),
+             LogField("slowest_us", slowestTick * 1e6));
+    LOG_INFO("World", LogField("level", world.getLevelIndex() + 1), LogField("wave", world.getEnemies().getCurrentWave()),
+             LogField("enemies", world.getEnemies().getActiveCount()),
+             LogField("candidate_pairs", candidatePairs), LogField("hits", hits), LogField("explosions", explosions));
+    LOG_INFO("Enemy animation", LogField("on_screen_enemy_ticks", onScreenEnemies),
+             LogField("suspended_enemy_ticks", offScreenEnemies));
+    if (deathTick > 0) {
+        LOG_INFO("Player died", LogField("tick", deathTick));
+    }
+    char checksum[17];
+    std::snprintf(checksum, sizeof(checksum), "%016llx", static_cast<unsigned long long>(stateChecksum(world)));
+    LOG_INFO("State checksum", LogField("tick", world.getTickCount()), LogField("checksum", checksum));
+
+    if (recordingRun && !playing && !recording.save(options.recordPath)) {
+        return 1;
+    }
+    return 0;
+}
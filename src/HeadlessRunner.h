@@ -0,0 +1,33 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <cstdint>
+#include <string>
+
+struct HeadlessOptions {
+    unsigned long ticks;
+    float tickDuration;
+    std::uint64_t seed;
+    std::string campaignPath; // Levels to play, see Level.h
+    std::string replayPath; // Play this replay instead of the scripted player
+    std::string recordPath; // Save the run as a replay
+    unsigned long seekTick; // With a replay, start measuring from this tick
+
+    HeadlessOptions() :
+        ticks(36000), // Ten minutes at 60 Hz
+        tickDuration(1.0f / 60.0f),
+        seed(0),
+        campaignPath("Assets/Levels/campaign.txt"),
+        seekTick(0)
+    {
+    }
+};
+
+// Runs the simulation for a fixed number of ticks as fast as the CPU allows,
+// with no window, textures or audio. A scripted player faces the nearest
+// zombie and keeps firing, so waves progress the way they do in play; a
+// replay can drive the run instead. Prints timing and world stats, returns
+// the process exit code.
+int runHeadless(const HeadlessOptions& options);
+
+#endif // HEADLESSRUNNER_H
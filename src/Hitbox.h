@@ -1,51 +1,114 @@
 #ifndef HITBOX_H
 #define HITBOX_H
 
-#include <SFML/Graphics.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cmath>
+#include <cstdint>
+#include "StateStream.h"
 
-class Hitbox {
-public:
-    // Constructor accepts a size and optionally a position
-    Hitbox(const sf::Vector2f& size = sf::Vector2f(0.0f, 0.0f));
+// Collision layers, a hitbox only reports hits against layers in its mask
+enum HitboxLayer : std::uint32_t {
+    HITBOX_LAYER_PLAYER = 1u << 0,
+    HITBOX_LAYER_ENEMY = 1u << 1,
+    HITBOX_LAYER_BULLET = 1u << 2,
+    HITBOX_LAYER_ALL = 0xFFFFFFFFu
+};
+
+// Plain axis-aligned box, cheap to copy and to test. Debug drawing lives
+// in HitboxOverlay so the box itself carries no SFML drawable.
+struct Hitbox {
+    sf::Vector2f center;   // Position of the hitbox
+    sf::Vector2f halfSize; // Half of the width and height
+    std::uint32_t layer;   // Layer this hitbox is on
+    std::uint32_t mask;    // Layers this hitbox collides with
+    bool active;           // Whether the hitbox is active or not
 
-    ~Hitbox();
+    // Constructor accepts a size, the hitbox is centered on its position
+    Hitbox(const sf::Vector2f& size = sf::Vector2f(0.0f, 0.0f),
+           std::uint32_t layer = HITBOX_LAYER_ALL, std::uint32_t mask = HITBOX_LAYER_ALL) :
+        center(0.0f, 0.0f),
+        halfSize(size.x / 2.0f, size.y / 2.0f),
+        layer(layer),
+        mask(mask),
+        active(true)
+    {
+    }
 
     // Set the position of the hitbox
-    void setPosition(float x, float y);
-    void setPosition(const sf::Vector2f& position);
+    void setPosition(float x, float y) {
+        center.x = x;
+        center.y = y;
+    }
+
+    void setPosition(const sf::Vector2f& position) {
+        center = position;
+    }
 
     // Set whether the hitbox is active
-    void setActive(bool active);
+    void setActive(bool active) {
+        this->active = active;
+    }
 
     // Get the position of the hitbox
-    sf::Vector2f getPosition() const;
+    sf::Vector2f getPosition() const {
+        return center;
+    }
 
     // Get the size of the hitbox
-    sf::Vector2f getSize() const;
+    sf::Vector2f getSize() const {
+        return sf::Vector2f(halfSize.x * 2.0f, halfSize.y * 2.0f);
+    }
 
     // Get the global bounds of the hitbox
-    sf::FloatRect getBounds() const;
+    sf::FloatRect getBounds() const {
+        return sf::FloatRect(center.x - halfSize.x, center.y - halfSize.y, halfSize.x * 2.0f, halfSize.y * 2.0f);
+    }
 
     // Check if the hitbox is active
-    bool isActive() const;
+    bool isActive() const {
+        return active;
+    }
 
-    // Check for intersection with another hitbox
-    bool intersects(const Hitbox& other) const;
+    // Check for intersection with another hitbox, honoring active flags and masks.
+    // Bitwise ands instead of && so the whole test compiles without branches.
+    bool intersects(const Hitbox& other) const {
+        bool overlapX = std::fabs(center.x - other.center.x) < halfSize.x + other.halfSize.x;
+        bool overlapY = std::fabs(center.y - other.center.y) < halfSize.y + other.halfSize.y;
+        bool layersMatch = (mask & other.layer) != 0;
+        return overlapX & overlapY & layersMatch & active & other.active;
+    }
 
     // Check for intersection with a rectangle
-    bool intersects(const sf::FloatRect& rect) const;
+    bool intersects(const sf::FloatRect& rect) const {
+        return checkCollision(rect) & active;
+    }
 
-    // Check for collision with another rectangle
-    bool checkCollision(const sf::FloatRect& otherBounds) const; // Add this method
+    // Check for collision with another rectangle, ignoring the active flag
+    bool checkCollision(const sf::FloatRect& otherBounds) const {
+        float otherHalfWidth = otherBounds.width / 2.0f;
+        float otherHalfHeight = otherBounds.height / 2.0f;
+        bool overlapX = std::fabs(center.x - (otherBounds.left + otherHalfWidth)) < halfSize.x + otherHalfWidth;
+        bool overlapY = std::fabs(center.y - (otherBounds.top + otherHalfHeight)) < halfSize.y + otherHalfHeight;
+        return overlapX & overlapY;
+    }
 
-    // Draw the hitbox (useful for debugging)
-    void draw(sf::RenderWindow& window);
+    // Field by field, so the padding after `active` never reaches a snapshot
+    void saveState(StateWriter& writer) const {
+        writer.write(center);
+        writer.write(halfSize);
+        writer.write(layer);
+        writer.write(mask);
+        writer.write(active);
+    }
 
-private:
-    sf::RectangleShape shape;  // Shape used to represent the hitbox visually
-    sf::Vector2f size;        // Size of the hitbox
-    sf::Vector2f position;    // Position of the hitbox
-    bool active;              // Whether the hitbox is active or not
+    void loadState(StateReader& reader) {
+        reader.read(center);
+        reader.read(halfSize);
+        reader.read(layer);
+        reader.read(mask);
+        reader.read(active);
+    }
 };
 
 #endif // HITBOX_H
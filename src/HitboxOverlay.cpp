@@ -0,0 +1,80 @@
+#include "HitboxOverlay.h"
+
+namespace {
+
+const sf::Color FILL_COLOR(0, 0, 255, 100); // Semi-transparent blue
+const sf::Color OUTLINE_COLOR = sf::Color::Red;
+const float OUTLINE_THICKNESS = 1.0f;
+
+} // namespace
+
+HitboxOverlay::HitboxOverlay() :
+    enabled(false),
+    submitted(false)
+{
+}
+
+void HitboxOverlay::setEnabled(bool enabled) {
+    this->enabled = enabled;
+    vertices.clear();
+}
+
+void HitboxOverlay::toggle() {
+    setEnabled(!enabled);
+}
+
+bool HitboxOverlay::isEnabled() const {
+    return enabled;
+}
+
+void HitboxOverlay::add(const Hitbox& hitbox) {
+    if (hitbox.isActive()) {
+        add(hitbox.getBounds());
+    }
+}
+
+void HitboxOverlay::add(const sf::FloatRect& bounds) {
+    if (!enabled) {
+        return;
+    }
+    if (submitted) {
+        // First box of a new frame
+        vertices.clear();
+        submitted = false;
+    }
+
+    addQuad(bounds, FILL_COLOR);
+
+    // Outline drawn outside the box, like sf::Shape does
+    float t = OUTLINE_THICKNESS;
+    float right = bounds.left + bounds.width;
+    float bottom = bounds.top + bounds.height;
+    addQuad(sf::FloatRect(bounds.left - t, bounds.top - t, bounds.width + 2 * t, t), OUTLINE_COLOR);
+    addQuad(sf::FloatRect(bounds.left - t, bottom, bounds.width + 2 * t, t), OUTLINE_COLOR);
+    addQuad(sf::FloatRect(bounds.left - t, bounds.top, t, bounds.height), OUTLINE_COLOR);
+    addQuad(sf::FloatRect(right, bounds.top, t, bounds.height), OUTLINE_COLOR);
+}
+
+void HitboxOverlay::addQuad(const sf::FloatRect& rect, const sf::Color& color) {
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+    vertices.push_back(sf::Vertex(topLeft, color));
+    vertices.push_back(sf::Vertex(topRight, color));
+    vertices.push_back(sf::Vertex(bottomRight, color));
+    vertices.push_back(sf::Vertex(topLeft, color));
+    vertices.push_back(sf::Vertex(bottomRight, color));
+    vertices.push_back(sf::Vertex(bottomLeft, color));
+}
+
+void HitboxOverlay::render(RenderQueue& queue) {
+    if (!enabled) {
+        return;
+    }
+    if (submitted) {
+        vertices.clear(); // Nothing was added this frame
+    }
+    submitted = true;
+    queue.submitVertices(LAYER_DEBUG, nullptr, vertices.data(), vertices.size());
+}
@@ -0,0 +1,32 @@
+#ifndef HITBOXOVERLAY_H
+#define HITBOXOVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Hitbox.h"
+#include "RenderQueue.h"
+
+// Debug view of every hitbox, drawn as a single vertex array when enabled
+class HitboxOverlay {
+public:
+    HitboxOverlay();
+
+    void setEnabled(bool enabled);
+    void toggle();
+    bool isEnabled() const;
+
+    // Queue boxes for this frame, ignored while the overlay is off
+    void add(const Hitbox& hitbox);
+    void add(const sf::FloatRect& bounds);
+
+    void render(RenderQueue& queue);
+
+private:
+    void addQuad(const sf::FloatRect& rect, const sf::Color& color);
+
+    std::vector<sf::Vertex> vertices; // Must outlive the queue flush, cleared on the next frame
+    bool enabled;
+    bool submitted; // Vertices were handed to the queue already
+};
+
+#endif // HITBOXOVERLAY_H
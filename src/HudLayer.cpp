@@ -0,0 +1,90 @@
+#include "HudLayer.h"
+#include <cstring>
+
+HudLayer::HudLayer() :
+    dirty(false),
+    rebuildCount(0)
+{
+}
+
+bool HudLayer::init(const sf::Font& font, const unsigned int* sizes, int sizeCount) {
+    return this->font.bake(font, sizes, sizeCount);
+}
+
+int HudLayer::addText(unsigned int characterSize, const sf::Vector2f& position, const sf::Color& color) {
+    TextSlot slot;
+    slot.sizeIndex = font.getSizeIndex(characterSize);
+    slot.position = position;
+    slot.color = color;
+    slot.text[0] = '\0';
+    slot.visible = true;
+    texts.push_back(slot);
+    return static_cast<int>(texts.size()) - 1;
+}
+
+void HudLayer::setText(int id, const char* text) {
+    TextSlot& slot = texts[id];
+    if (std::strncmp(slot.text, text, MAX_TEXT_LENGTH) == 0) {
+        return;
+    }
+    std::strncpy(slot.text, text, MAX_TEXT_LENGTH);
+    slot.text[MAX_TEXT_LENGTH] = '\0';
+    dirty = true;
+}
+
+void HudLayer::setVisible(int id, bool visible) {
+    if (texts[id].visible != visible) {
+        texts[id].visible = visible;
+        dirty = true;
+    }
+}
+
+void HudLayer::render(RenderQueue& queue) {
+    if (dirty) {
+        rebuild();
+    }
+    queue.submitVertices(LAYER_HUD, &font.getTexture(), vertices.data(), vertices.size());
+}
+
+unsigned int HudLayer::getRebuildCount() const {
+    return rebuildCount;
+}
+
+void HudLayer::rebuild() {
+    vertices.clear();
+    for (const TextSlot& slot : texts) {
+        if (slot.visible && slot.sizeIndex >= 0) {
+            appendText(slot);
+        }
+    }
+    dirty = false;
+    rebuildCount++;
+}
+
+void HudLayer::appendText(const TextSlot& slot) {
+    // Same layout as sf::Text: the baseline sits one character size below the top
+    float x = slot.position.x;
+    float y = slot.position.y + font.getCharacterSize(slot.sizeIndex);
+    for (const char* c = slot.text; *c != '\0'; c++) {
+        const BitmapGlyph& glyph = font.getGlyph(slot.sizeIndex, *c);
+        const sf::FloatRect& b = glyph.bounds;
+        const sf::IntRect& t = glyph.textureRect;
+        if (t.width > 0) {
+            float left = static_cast<float>(t.left);
+            float top = static_cast<float>(t.top);
+            float right = static_cast<float>(t.left + t.width);
+            float bottom = static_cast<float>(t.top + t.height);
+            sf::Vertex topLeft(sf::Vector2f(x + b.left, y + b.top), slot.color, sf::Vector2f(left, top));
+            sf::Vertex topRight(sf::Vector2f(x + b.left + b.width, y + b.top), slot.color, sf::Vector2f(right, top));
+            sf::Vertex bottomRight(sf::Vector2f(x + b.left + b.width, y + b.top + b.height), slot.color, sf::Vector2f(right, bottom));
+            sf::Vertex bottomLeft(sf::Vector2f(x + b.left, y + b.top + b.height), slot.color, sf::Vector2f(left, bottom));
+            vertices.push_back(topLeft);
+            vertices.push_back(topRight);
+            vertices.push_back(bottomRight);
+            vertices.push_back(topLeft);
+            vertices.push_back(bottomRight);
+            vertices.push_back(bottomLeft);
+        }
+        x += glyph.advance;
+    }
+}
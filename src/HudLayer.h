@@ -0,0 +1,52 @@
+#ifndef HUDLAYER_H
+#define HUDLAYER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "BitmapFont.h"
+#include "RenderQueue.h"
+
+// Screen-space text drawn from a BitmapFont. Texts are fixed slots created
+// up front; setText() only flags a rebuild when the characters differ, and
+// the glyph quads of every text are kept in one vertex array that is rebuilt
+// only then. A frame where nothing changed costs a single batched draw.
+class HudLayer {
+public:
+    static const int MAX_TEXT_LENGTH = 31;
+
+    HudLayer();
+
+    // Bake the glyphs of every character size the texts will use
+    bool init(const sf::Font& font, const unsigned int* sizes, int sizeCount);
+
+    // Returns the id of the new text. The size must be one of the baked ones.
+    int addText(unsigned int characterSize, const sf::Vector2f& position, const sf::Color& color);
+    // Longer texts are cut at MAX_TEXT_LENGTH
+    void setText(int id, const char* text);
+    void setVisible(int id, bool visible);
+
+    void render(RenderQueue& queue);
+
+    // Times the vertex array was rebuilt
+    unsigned int getRebuildCount() const;
+
+private:
+    struct TextSlot {
+        int sizeIndex;
+        sf::Vector2f position; // Top-left, like sf::Text
+        sf::Color color;
+        char text[MAX_TEXT_LENGTH + 1];
+        bool visible;
+    };
+
+    void rebuild();
+    void appendText(const TextSlot& slot);
+
+    BitmapFont font;
+    std::vector<TextSlot> texts;
+    std::vector<sf::Vertex> vertices; // Must outlive the queue flush
+    bool dirty;
+    unsigned int rebuildCount;
+};
+
+#endif // HUDLAYER_H
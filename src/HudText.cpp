@@ -0,0 +1,34 @@
+#include "HudText.h"
+#include <cstdio>
+
+namespace {
+
+// snprintf returns the untruncated length, clamp it to what was written
+int written(int length, std::size_t size) {
+    if (length < 0 || size == 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(length) < size ? length : static_cast<int>(size) - 1;
+}
+
+} // namespace
+
+int formatAmmo(char* buffer, std::size_t size, int remaining, int max) {
+    return written(std::snprintf(buffer, size, "Ammo: %d / %d", remaining, max), size);
+}
+
+int formatHealth(char* buffer, std::size_t size, float health) {
+    return written(std::snprintf(buffer, size, "Health: %d", static_cast<int>(health)), size);
+}
+
+int formatGrenades(char* buffer, std::size_t size, int remaining) {
+    return written(std::snprintf(buffer, size, "Grenades: %d", remaining), size);
+}
+
+int formatWave(char* buffer, std::size_t size, int wave) {
+    return written(std::snprintf(buffer, size, "Wave: %d", wave), size);
+}
+
+int formatWaveBanner(char* buffer, std::size_t size, int wave) {
+    return written(std::snprintf(buffer, size, "Wave %d", wave), size);
+}
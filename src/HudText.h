@@ -0,0 +1,14 @@
+#ifndef HUDTEXT_H
+#define HUDTEXT_H
+
+#include <cstddef>
+
+// Strings shown by the HUD, formatted into the caller's buffer without
+// allocating. Each returns the length written; the text is cut to fit.
+int formatAmmo(char* buffer, std::size_t size, int remaining, int max);
+int formatHealth(char* buffer, std::size_t size, float health);
+int formatGrenades(char* buffer, std::size_t size, int remaining);
+int formatWave(char* buffer, std::size_t size, int wave);
+int formatWaveBanner(char* buffer, std::size_t size, int wave); // Centered "Wave N" shown between waves
+
+#endif // HUDTEXT_H
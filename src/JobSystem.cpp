@@ -0,0 +1,147 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace {
+
+// Index of the queue owned by this thread, 0 for non-workers
+thread_local unsigned int currentQueue = 0;
+
+} // namespace
+
+JobSystem& JobSystem::instance() {
+    static JobSystem jobSystem;
+    return jobSystem;
+}
+
+JobSystem::JobSystem() :
+    queuedJobs(0),
+    running(false)
+{
+    queues.emplace_back(new WorkQueue());
+}
+
+JobSystem::~JobSystem() {
+    stop();
+}
+
+void JobSystem::start(unsigned int workerCount) {
+    stop();
+    if (workerCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    running = true;
+    for (unsigned int i = 0; i < workerCount; i++) {
+        queues.emplace_back(new WorkQueue());
+    }
+    for (unsigned int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::runWorker, this, i + 1);
+    }
+}
+
+void JobSystem::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+    queues.resize(1);
+}
+
+unsigned int JobSystem::getWorkerCount() const {
+    return static_cast<unsigned int>(workers.size());
+}
+
+void JobSystem::parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body) {
+    chunkSize = std::max(chunkSize, 1);
+    if (workers.empty() || count <= chunkSize) {
+        // Not worth waking anyone
+        if (count > 0) {
+            body(0, count);
+        }
+        return;
+    }
+
+    int chunkCount = (count + chunkSize - 1) / chunkSize;
+    std::atomic<int> remaining(chunkCount);
+    {
+        WorkQueue& queue = *queues[currentQueue];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (int begin = 0; begin < count; begin += chunkSize) {
+            Job job = { &body, begin, std::min(begin + chunkSize, count), &remaining };
+            queue.jobs.push_back(job);
+        }
+    }
+    queuedJobs += chunkCount;
+    {
+        // Taking the lock orders this with a worker about to sleep
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_all();
+
+    // Help out until our own loop is finished, possibly running other loops' chunks
+    Job job;
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (popOrSteal(currentQueue, job)) {
+            execute(job);
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::runWorker(unsigned int index) {
+    currentQueue = index;
+    Job job;
+    for (;;) {
+        if (popOrSteal(index, job)) {
+            execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this] { return queuedJobs.load() > 0 || !running; });
+        if (!running) {
+            return;
+        }
+    }
+}
+
+bool JobSystem::popOrSteal(unsigned int index, Job& job) {
+    // Own queue first, newest job (still warm in cache)
+    {
+        WorkQueue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.jobs.empty()) {
+            job = queue.jobs.back();
+            queue.jobs.pop_back();
+            queuedJobs--;
+            return true;
+        }
+    }
+
+    // Then the oldest job of the next queue that has one
+    std::size_t queueCount = queues.size();
+    for (std::size_t offset = 1; offset < queueCount; offset++) {
+        WorkQueue& victim = *queues[(index + offset) % queueCount];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            queuedJobs--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void JobSystem::execute(const Job& job) {
+    (*job.body)(job.begin, job.end);
+    job.remaining->fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,65 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small work-stealing thread pool for data-parallel loops. Every worker owns
+// a deque: it pops its own work from the back and steals from the front of
+// the others when it runs dry. The thread calling parallelFor helps until
+// its loop is done. Until start() is called everything runs inline on the
+// caller, which is what the headless tools and benchmarks get by default.
+class JobSystem {
+public:
+    static JobSystem& instance();
+
+    // 0 workers means one per hardware thread besides the caller's
+    void start(unsigned int workerCount = 0);
+    void stop();
+    unsigned int getWorkerCount() const;
+
+    // Call body(begin, end) for chunks of at most chunkSize indices covering
+    // [0, count), spread over the workers; returns once every chunk ran.
+    // Chunks run in no particular order, so body must only write state
+    // owned by its own indices.
+    void parallelFor(int count, int chunkSize, const std::function<void(int, int)>& body);
+
+private:
+    struct Job {
+        const std::function<void(int, int)>* body;
+        int begin;
+        int end;
+        std::atomic<int>* remaining; // Chunks of the loop still running
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    JobSystem();
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void runWorker(unsigned int index);
+    bool popOrSteal(unsigned int index, Job& job);
+    void execute(const Job& job);
+
+    // queues[0] belongs to every thread that is not a worker
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedJobs;
+    std::atomic<bool> running;
+};
+
+#endif // JOBSYSTEM_H
@@ -0,0 +1,258 @@
+#include "Level.h"
+#include "Camera.h"
+#include "Log.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Enemy types by the name of their atlas character
+bool parseEnemyType(const std::string& name, EnemyType& type) {
+    if (name == "Zombie") {
+        type = ZOMBIE_1;
+        return true;
+    }
+    if (name == "Zombie_2") {
+        type = ZOMBIE_2;
+        return true;
+    }
+    return false;
+}
+
+WaveDefinition makeWave(int killQuota, float spawnInterval, int zombie2Weight) {
+    WaveDefinition wave;
+    wave.killQuota = killQuota;
+    wave.spawnIntervalStart = spawnInterval;
+    wave.spawnIntervalEnd = spawnInterval;
+    WaveRosterEntry zombie = { ZOMBIE_1, 1 };
+    wave.roster.push_back(zombie);
+    if (zombie2Weight > 0) {
+        WaveRosterEntry zombie2 = { ZOMBIE_2, zombie2Weight };
+        wave.roster.push_back(zombie2);
+    }
+    wave.totalWeight = 1 + zombie2Weight;
+    return wave;
+}
+
+LevelDefinition makeDefaultLevel() {
+    LevelDefinition level;
+    level.name = "Crash Site";
+    level.width = 5120.0f;
+    level.musicPath = "Assets/Damned.mp3";
+    level.backgroundPaths.push_back("Assets/Backgrounds/background.png");
+    SpawnZone left = { false, 100.0f, 300.0f };
+    SpawnZone right = { true, 100.0f, 300.0f };
+    level.zones.push_back(left);
+    level.zones.push_back(right);
+    level.waves.push_back(makeWave(10, 2.0f, 0));
+    level.waves.push_back(makeWave(20, 1.0f, 1));
+    level.waves.push_back(makeWave(30, 0.5f, 1));
+    level.endlessQuotaStep = 10;
+    return level;
+}
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// WaveDefinition Implementation
+//------------------------------------------------------------------------------
+
+float WaveDefinition::getSpawnInterval(int kills) const {
+    float progress = std::min(1.0f, static_cast<float>(kills) / killQuota);
+    return spawnIntervalStart + (spawnIntervalEnd - spawnIntervalStart) * progress;
+}
+
+EnemyType WaveDefinition::pickType(int roll) const {
+    for (const WaveRosterEntry& entry : roster) {
+        if (roll < entry.weight) {
+            return entry.type;
+        }
+        roll -= entry.weight;
+    }
+    return roster.back().type;
+}
+
+//------------------------------------------------------------------------------
+// LevelDefinition Implementation
+//------------------------------------------------------------------------------
+
+LevelDefinition::LevelDefinition() :
+    width(Camera::VIEW_WIDTH),
+    waveDelay(3.0f),
+    endlessQuotaStep(0)
+{
+}
+
+bool LevelDefinition::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG_ERROR("Failed to open level", LogField("path", path));
+        return false;
+    }
+
+    LevelDefinition level;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream in(line);
+        std::string keyword;
+        in >> keyword;
+        bool good = true;
+        if (keyword == "name") {
+            good = static_cast<bool>(std::getline(in >> std::ws, level.name));
+        }
+        else if (keyword == "width") {
+            good = (in >> level.width) && level.width >= Camera::VIEW_WIDTH;
+        }
+        else if (keyword == "music") {
+            good = static_cast<bool>(in >> level.musicPath);
+        }
+        else if (keyword == "background") {
+            std::string background;
+            good = static_cast<bool>(in >> background);
+            level.backgroundPaths.push_back(background);
+        }
+        else if (keyword == "zone") {
+            std::string side;
+            SpawnZone zone;
+            good = (in >> side >> zone.minDistance >> zone.maxDistance) && (side == "left" || side == "right") &&
+                   zone.minDistance <= zone.maxDistance;
+            zone.right = side == "right";
+            level.zones.push_back(zone);
+        }
+        else if (keyword == "delay") {
+            good = (in >> level.waveDelay) && level.waveDelay >= 0.0f;
+        }
+        else if (keyword == "wave") {
+            WaveDefinition wave;
+            wave.totalWeight = 0;
+            good = (in >> wave.killQuota >> wave.spawnIntervalStart >> wave.spawnIntervalEnd) && wave.killQuota > 0 &&
+                   wave.spawnIntervalStart > 0.0f && wave.spawnIntervalEnd > 0.0f;
+            level.waves.push_back(wave);
+        }
+        else if (keyword == "enemy") {
+            std::string typeName;
+            WaveRosterEntry entry;
+            good = (in >> typeName >> entry.weight) && parseEnemyType(typeName, entry.type) && entry.weight > 0 &&
+                   !level.waves.empty();
+            if (good) {
+                level.waves.back().roster.push_back(entry);
+                level.waves.back().totalWeight += entry.weight;
+            }
+        }
+        else if (keyword == "endless") {
+            good = (in >> level.endlessQuotaStep) && level.endlessQuotaStep > 0;
+        }
+        else {
+            good = false;
+        }
+
+        if (!good) {
+            LOG_ERROR("Malformed level line", LogField("path", path), LogField("line", lineNumber));
+            return false;
+        }
+    }
+
+    if (level.zones.empty() || level.waves.empty()) {
+        LOG_ERROR("Level needs at least one zone and one wave", LogField("path", path));
+        return false;
+    }
+    for (const WaveDefinition& wave : level.waves) {
+        if (wave.roster.empty()) {
+            LOG_ERROR("Level has a wave without enemies", LogField("path", path));
+            return false;
+        }
+    }
+
+    *this = level;
+    return true;
+}
+
+int LevelDefinition::getWaveCount() const {
+    return static_cast<int>(waves.size());
+}
+
+const WaveDefinition& LevelDefinition::getWave(int number) const {
+    int index = std::min(std::max(number, 1), getWaveCount()) - 1;
+    return waves[index];
+}
+
+int LevelDefinition::getKillQuota(int number) const {
+    int extraWaves = std::max(0, number - getWaveCount());
+    return getWave(number).killQuota + extraWaves * endlessQuotaStep;
+}
+
+bool LevelDefinition::isLastWave(int number) const {
+    return endlessQuotaStep == 0 && number >= getWaveCount();
+}
+
+void LevelDefinition::getTexturePaths(std::vector<std::string>& paths) const {
+    paths.insert(paths.end(), backgroundPaths.begin(), backgroundPaths.end());
+}
+
+const LevelDefinition& LevelDefinition::getDefault() {
+    static const LevelDefinition level = makeDefaultLevel();
+    return level;
+}
+
+//------------------------------------------------------------------------------
+// Campaign Implementation
+//------------------------------------------------------------------------------
+
+Campaign::Campaign() :
+    levels(1, LevelDefinition::getDefault())
+{
+}
+
+bool Campaign::load(const std::string& path) {
+    levels.assign(1, LevelDefinition::getDefault());
+
+    std::ifstream file(path);
+    if (!file) {
+        LOG_INFO("No campaign, playing the default level", LogField("path", path));
+        return false;
+    }
+
+    // Level files are listed one per line, relative to the working directory
+    std::vector<LevelDefinition> loaded;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string keyword;
+        std::string levelPath;
+        if (line.empty() || line[0] == '#' || !(in >> keyword)) {
+            continue;
+        }
+        loaded.emplace_back();
+        if (keyword != "level" || !(in >> levelPath) || !loaded.back().load(levelPath)) {
+            LOG_ERROR("Broken campaign, playing the default level", LogField("path", path));
+            return false;
+        }
+    }
+    if (loaded.empty()) {
+        LOG_ERROR("Empty campaign, playing the default level", LogField("path", path));
+        return false;
+    }
+
+    levels.swap(loaded);
+    return true;
+}
+
+int Campaign::getLevelCount() const {
+    return static_cast<int>(levels.size());
+}
+
+const LevelDefinition& Campaign::getLevel(int index) const {
+    return levels[index];
+}
+
+const Campaign& Campaign::getDefault() {
+    static const Campaign campaign;
+    return campaign;
+}
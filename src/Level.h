@@ -0,0 +1,94 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <string>
+#include <vector>
+#include "Enemy.h"
+
+// Where zombies walk in from, measured from the edge of the screen
+struct SpawnZone {
+    bool right;
+    float minDistance;
+    float maxDistance;
+};
+
+struct WaveRosterEntry {
+    EnemyType type;
+    int weight; // Relative chance of each spawn being this type
+};
+
+struct WaveDefinition {
+    int killQuota; // Kills that clear the wave
+    // Seconds between spawns, eased from start to end as the quota fills up
+    float spawnIntervalStart;
+    float spawnIntervalEnd;
+    std::vector<WaveRosterEntry> roster;
+    int totalWeight;
+
+    float getSpawnInterval(int kills) const;
+    EnemyType pickType(int roll) const; // roll in [0, totalWeight)
+};
+
+// One stage of the campaign, read from a text file such as
+// Assets/Levels/crash_site.txt:
+//
+//   name <name>
+//   width <pixels>                     (how far the level scrolls, at least a screen)
+//   music <file>
+//   background <file>                  (drawn in order, back to front)
+//   zone left|right <min> <max>
+//   delay <seconds between waves>
+//   wave <kill quota> <start interval> <end interval>
+//   enemy <Zombie|Zombie_2> <weight>   (adds to the wave above)
+//   endless <quota step>               (last wave repeats, quota grows by step)
+//
+// Without endless the level is complete once its last wave is cleared.
+struct LevelDefinition {
+    LevelDefinition();
+
+    // Returns false (and logs) if the file is missing or malformed
+    bool load(const std::string& path);
+
+    int getWaveCount() const;
+    // Waves are numbered from 1; past the last one an endless level repeats it
+    const WaveDefinition& getWave(int number) const;
+    int getKillQuota(int number) const;
+    bool isLastWave(int number) const; // Always false for an endless level
+
+    void getTexturePaths(std::vector<std::string>& paths) const;
+
+    // The original endless pacing: quota 10 per wave, spawns twice as fast
+    // each wave down to 0.5 s, the faster zombie from wave 2
+    static const LevelDefinition& getDefault();
+
+    std::string name;
+    float width; // World pixels, the background tiles across all of it
+    std::string musicPath;
+    std::vector<std::string> backgroundPaths;
+    std::vector<SpawnZone> zones;
+    std::vector<WaveDefinition> waves;
+    float waveDelay;
+    int endlessQuotaStep; // 0 for a level that ends
+};
+
+// The levels in play order. Definitions are a few hundred bytes each and all
+// parsed up front, so the simulation never waits on the disk; what streams
+// in the background are the levels' assets (see LevelManager).
+class Campaign {
+public:
+    Campaign(); // Just the default level
+
+    // Falls back to the default level and returns false if the campaign
+    // file or any of its levels cannot be read
+    bool load(const std::string& path);
+
+    int getLevelCount() const;
+    const LevelDefinition& getLevel(int index) const;
+
+    static const Campaign& getDefault();
+
+private:
+    std::vector<LevelDefinition> levels;
+};
+
+#endif // LEVEL_H
@@ -0,0 +1,150 @@
+#include "LevelManager.h"
+#include "Log.h"
+#include "ResourceCache.h"
+#include <algorithm>
+
+LevelManager::LevelManager() :
+    campaign(&Campaign::getDefault()),
+    current(-1),
+    prefetchIndex(-1),
+    prefetched(false)
+{
+}
+
+void LevelManager::init(const Campaign& campaign) {
+    this->campaign = &campaign;
+}
+
+void LevelManager::enter(int index) {
+    if (index == current) {
+        return;
+    }
+
+    // Take over the prefetch when it is for this level, otherwise drop it
+    if (loader && prefetchIndex == index) {
+        finishPrefetch();
+    }
+    loader.reset();
+    std::vector<std::shared_ptr<sf::Texture>> textures;
+    if (prefetched && prefetchIndex == index) {
+        textures.swap(nextBackgrounds);
+    }
+    else {
+        acquireTextures(index, textures); // Loads whatever is missing right now
+    }
+    nextBackgrounds.clear();
+    prefetched = false;
+    prefetchIndex = -1;
+
+    // The render thread still draws the old textures from snapshots already
+    // handed over, so they are only retired here and released by update()
+    backgrounds.swap(textures);
+    for (const std::shared_ptr<sf::Texture>& texture : textures) {
+        retired.push_back(texture);
+    }
+    retired.erase(std::remove_if(retired.begin(), retired.end(),
+        [this](const std::weak_ptr<sf::Texture>& texture) {
+            return texture.expired() || std::find(backgrounds.begin(), backgrounds.end(), texture.lock()) != backgrounds.end();
+        }), retired.end());
+    textures.clear();
+    current = index;
+
+    const LevelDefinition& level = campaign->getLevel(index);
+    LOG_INFO("Entering level", LogField("level", index + 1), LogField("name", level.name));
+    if (level.musicPath != musicPath) {
+        musicPath = level.musicPath;
+        music.stop();
+        if (music.openFromFile(musicPath)) {
+            music.setLoop(true);
+            music.play();
+        }
+        else {
+            LOG_WARN("Failed to open level music", LogField("path", musicPath));
+        }
+    }
+
+    // Prefetching now would skip textures that are about to be released
+    if (retired.empty() && index + 1 < campaign->getLevelCount()) {
+        prefetch(index + 1);
+    }
+}
+
+void LevelManager::update(sf::Time budget) {
+    if (!retired.empty() && releaseRetired() && current + 1 < campaign->getLevelCount()) {
+        prefetch(current + 1);
+    }
+    if (!loader) {
+        return;
+    }
+    loader->update(budget);
+    if (loader->isFinished()) {
+        loader.reset();
+        acquireTextures(prefetchIndex, nextBackgrounds); // All cache hits now
+        prefetched = true;
+    }
+}
+
+void LevelManager::prefetch(int index) {
+    std::vector<std::string> paths;
+    campaign->getLevel(index).getTexturePaths(paths);
+
+    // One worker, the current level is playing on the other cores
+    prefetchIndex = index;
+    loader.reset(new AssetLoader());
+    for (const std::string& path : paths) {
+        if (!ResourceCache::instance().hasTexture(path)) {
+            loader->add(ASSET_TEXTURE, path);
+        }
+    }
+    loader->start(1);
+}
+
+bool LevelManager::releaseRetired() {
+    // Only the cache's own reference left, the render thread has moved on
+    for (const std::weak_ptr<sf::Texture>& texture : retired) {
+        if (texture.use_count() > 1) {
+            return false;
+        }
+    }
+    retired.clear();
+    ResourceCache::instance().releaseUnused();
+    LOG_INFO("Released previous level", LogField("resident_kb", ResourceCache::instance().getResidentBytes() / 1024));
+    return true;
+}
+
+void LevelManager::finishPrefetch() {
+    while (!loader->isFinished()) {
+        loader->update(sf::seconds(1.0f));
+        sf::sleep(sf::milliseconds(1));
+    }
+    loader.reset();
+    acquireTextures(prefetchIndex, nextBackgrounds);
+    prefetched = true;
+}
+
+void LevelManager::acquireTextures(int index, std::vector<std::shared_ptr<sf::Texture>>& textures) {
+    textures.clear();
+    const LevelDefinition& level = campaign->getLevel(index);
+    for (const std::string& path : level.backgroundPaths) {
+        std::shared_ptr<sf::Texture> texture = ResourceCache::instance().getTexture(path);
+        if (texture) {
+            textures.push_back(texture);
+        }
+    }
+}
+
+int LevelManager::getCurrentIndex() const {
+    return current;
+}
+
+const LevelDefinition& LevelManager::getCurrentLevel() const {
+    return campaign->getLevel(current < 0 ? 0 : current);
+}
+
+const std::vector<std::shared_ptr<sf::Texture>>& LevelManager::getBackgrounds() const {
+    return backgrounds;
+}
+
+bool LevelManager::isNextLevelReady() const {
+    return prefetched;
+}
@@ -0,0 +1,64 @@
+#ifndef LEVELMANAGER_H
+#define LEVELMANAGER_H
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include "AssetLoader.h"
+#include "Level.h"
+
+// Presentation side of the campaign: the current level's backgrounds and
+// music. While a level plays, the next one's textures are decoded on a
+// background worker and uploaded a little per frame, so the switch between
+// stages does not stall. What only the previous level used is released
+// once the render thread has let go of it too, which takes a few frames
+// after entering; the next prefetch starts after that. Main thread only.
+// Holds the cache's textures, so they are released before the cache is.
+class LevelManager {
+public:
+    LevelManager();
+
+    // The campaign has to outlive the manager
+    void init(const Campaign& campaign);
+    // Show a level: takes the prefetched textures (or loads them now if the
+    // prefetch has not finished) and cues its music. The previous level's
+    // resources are released and the next level prefetched from update()
+    void enter(int index);
+    // Release the previous level once nothing else holds it, then upload
+    // prefetched textures, spending at most budget
+    void update(sf::Time budget);
+
+    int getCurrentIndex() const; // -1 before the first enter
+    const LevelDefinition& getCurrentLevel() const;
+    // Back to front, held here so the cache keeps them while the level plays
+    const std::vector<std::shared_ptr<sf::Texture>>& getBackgrounds() const;
+    bool isNextLevelReady() const;
+
+private:
+    LevelManager(const LevelManager&) = delete;
+    LevelManager& operator=(const LevelManager&) = delete;
+
+    void prefetch(int index);
+    bool releaseRetired(); // True once the previous level's resources are gone
+    void finishPrefetch();
+    void acquireTextures(int index, std::vector<std::shared_ptr<sf::Texture>>& textures);
+
+    const Campaign* campaign;
+    int current;
+    std::vector<std::shared_ptr<sf::Texture>> backgrounds;
+    // Previous levels' textures the current one does not use, still held by
+    // snapshots or the render thread; not owned, so they can drop to the cache's reference
+    std::vector<std::weak_ptr<sf::Texture>> retired;
+
+    std::unique_ptr<AssetLoader> loader; // Decoding the next level, if any
+    int prefetchIndex;
+    bool prefetched; // nextBackgrounds holds level prefetchIndex
+    std::vector<std::shared_ptr<sf::Texture>> nextBackgrounds;
+
+    sf::Music music;
+    std::string musicPath;
+};
+
+#endif // LEVELMANAGER_H
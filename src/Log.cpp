@@ -0,0 +1,275 @@
+#include "Log.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+namespace {
+
+const char* const LEVEL_NAMES[] = { "TRACE", "DEBUG", "INFO ", "WARN ", "ERROR" };
+
+const std::chrono::milliseconds IDLE_SLEEP(5); // Producers never wake the writer, it polls
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// LogField Implementation
+//------------------------------------------------------------------------------
+
+LogField::LogField() :
+    key(""),
+    type(NONE),
+    intValue(0),
+    uintValue(0),
+    floatValue(0.0)
+{
+    text[0] = '\0';
+}
+
+LogField::LogField(const char* key, int value) :
+    LogField(key, static_cast<long long>(value))
+{
+}
+
+LogField::LogField(const char* key, unsigned int value) :
+    LogField(key, static_cast<unsigned long long>(value))
+{
+}
+
+LogField::LogField(const char* key, long value) :
+    LogField(key, static_cast<long long>(value))
+{
+}
+
+LogField::LogField(const char* key, unsigned long value) :
+    LogField(key, static_cast<unsigned long long>(value))
+{
+}
+
+LogField::LogField(const char* key, long long value) :
+    LogField()
+{
+    this->key = key;
+    type = INT;
+    intValue = value;
+}
+
+LogField::LogField(const char* key, unsigned long long value) :
+    LogField()
+{
+    this->key = key;
+    type = UINT;
+    uintValue = value;
+}
+
+LogField::LogField(const char* key, float value) :
+    LogField(key, static_cast<double>(value))
+{
+}
+
+LogField::LogField(const char* key, double value) :
+    LogField()
+{
+    this->key = key;
+    type = FLOAT;
+    floatValue = value;
+}
+
+LogField::LogField(const char* key, bool value) :
+    LogField(key, value ? "true" : "false")
+{
+}
+
+LogField::LogField(const char* key, const char* value) :
+    LogField()
+{
+    this->key = key;
+    type = TEXT;
+    std::strncpy(text, value, TEXT_SIZE - 1);
+    text[TEXT_SIZE - 1] = '\0';
+}
+
+LogField::LogField(const char* key, const std::string& value) :
+    LogField(key, value.c_str())
+{
+}
+
+//------------------------------------------------------------------------------
+// LogRateLimit Implementation
+//------------------------------------------------------------------------------
+
+LogRateLimit::LogRateLimit() :
+    window(0),
+    count(0),
+    skipped(0)
+{
+}
+
+bool LogRateLimit::allow(std::uint64_t nowUs, unsigned int& suppressed) {
+    std::uint64_t second = nowUs / 1000000;
+    std::uint64_t current = window.load(std::memory_order_relaxed);
+    if (second != current && window.compare_exchange_strong(current, second, std::memory_order_relaxed)) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    if (count.fetch_add(1, std::memory_order_relaxed) >= LIMIT) {
+        skipped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    suppressed = skipped.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// Logger Implementation
+//------------------------------------------------------------------------------
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() :
+    cells(new Cell[CAPACITY]),
+    enqueuePosition(0),
+    dequeuePosition(0),
+    written(0),
+    dropped(0),
+    minLevel(LOG_LEVEL_TRACE),
+    running(true),
+    startTime(0)
+{
+    for (std::size_t i = 0; i < CAPACITY; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    startTime = now();
+    thread = std::thread(&Logger::run, this);
+}
+
+Logger::~Logger() {
+    running = false;
+    thread.join();
+}
+
+std::uint64_t Logger::now() const {
+    std::uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return us - startTime;
+}
+
+void Logger::setMinLevel(LogLevel level) {
+    minLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::flush() {
+    std::size_t target = enqueuePosition.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+std::uint64_t Logger::getDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+// Bounded multi-producer queue: every cell carries a sequence number telling
+// producers whether it is free for their position and the writer whether it
+// was filled
+void Logger::push(LogLevel level, const char* message, unsigned int suppressed, const LogField* fields, int fieldCount) {
+    std::size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells[position & (CAPACITY - 1)];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed); // Full, the writer is behind
+            return;
+        }
+        else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    LogRecord& record = cell->record;
+    record.level = level;
+    record.time = now();
+    record.message = message;
+    record.suppressed = suppressed;
+    record.fieldCount = fieldCount;
+    for (int i = 0; i < fieldCount; i++) {
+        record.fields[i] = fields[i];
+    }
+    cell->sequence.store(position + 1, std::memory_order_release);
+}
+
+bool Logger::pop(LogRecord& record) {
+    Cell& cell = cells[dequeuePosition & (CAPACITY - 1)];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+        return false;
+    }
+    record = cell.record;
+    cell.sequence.store(dequeuePosition + CAPACITY, std::memory_order_release);
+    dequeuePosition++;
+    return true;
+}
+
+void Logger::run() {
+    LogRecord record;
+    std::size_t pending = 0;
+    for (;;) {
+        if (pop(record)) {
+            write(record);
+            pending++;
+            continue;
+        }
+
+        // Out of work: one flush for the whole batch
+        if (pending > 0) {
+            std::cout.flush();
+            std::cerr.flush();
+            written.fetch_add(pending, std::memory_order_release);
+            pending = 0;
+        }
+        if (!running && enqueuePosition.load(std::memory_order_acquire) == dequeuePosition) {
+            return;
+        }
+        std::this_thread::sleep_for(IDLE_SLEEP);
+    }
+}
+
+void Logger::write(const LogRecord& record) {
+    std::ostream& out = record.level >= LOG_LEVEL_WARN ? std::cerr : std::cout;
+
+    char prefix[32];
+    std::snprintf(prefix, sizeof(prefix), "[%10.3f] ", record.time / 1e6);
+    out << prefix << LEVEL_NAMES[record.level] << " " << record.message;
+    for (int i = 0; i < record.fieldCount; i++) {
+        const LogField& field = record.fields[i];
+        out << " " << field.key << "=";
+        switch (field.type) {
+        case LogField::INT:
+            out << field.intValue;
+            break;
+        case LogField::UINT:
+            out << field.uintValue;
+            break;
+        case LogField::FLOAT:
+            out << field.floatValue;
+            break;
+        case LogField::TEXT:
+            out << field.text;
+            break;
+        case LogField::NONE:
+            break;
+        }
+    }
+    if (record.suppressed > 0) {
+        out << " suppressed=" << record.suppressed;
+    }
+    out << '\n';
+}
@@ -0,0 +1,179 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+enum LogLevel {
+    LOG_LEVEL_TRACE = 0,
+    LOG_LEVEL_DEBUG = 1,
+    LOG_LEVEL_INFO = 2,
+    LOG_LEVEL_WARN = 3,
+    LOG_LEVEL_ERROR = 4
+};
+
+// Calls below this level are compiled out, e.g. -DLOG_MIN_LEVEL=1 keeps debug logs
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 2
+#endif
+
+const int LOG_MAX_FIELDS = 6;
+
+// One key=value pair. Text is copied (and cut at TEXT_SIZE - 1), keys must
+// be string literals.
+struct LogField {
+    enum Type {
+        NONE,
+        INT,
+        UINT,
+        FLOAT,
+        TEXT
+    };
+
+    static const std::size_t TEXT_SIZE = 48;
+
+    LogField();
+    LogField(const char* key, int value);
+    LogField(const char* key, unsigned int value);
+    LogField(const char* key, long value);
+    LogField(const char* key, unsigned long value);
+    LogField(const char* key, long long value);
+    LogField(const char* key, unsigned long long value);
+    LogField(const char* key, float value);
+    LogField(const char* key, double value);
+    LogField(const char* key, bool value);
+    LogField(const char* key, const char* value);
+    LogField(const char* key, const std::string& value);
+
+    const char* key;
+    Type type;
+    std::int64_t intValue;
+    std::uint64_t uintValue;
+    double floatValue;
+    char text[TEXT_SIZE];
+};
+
+// Per call site limit: the first LIMIT messages of every second get
+// through, the rest are counted and reported with the next one that does
+class LogRateLimit {
+public:
+    static const unsigned int LIMIT = 10;
+
+    LogRateLimit();
+
+    // suppressed receives how many messages were skipped before this one
+    bool allow(std::uint64_t nowUs, unsigned int& suppressed);
+
+private:
+    std::atomic<std::uint64_t> window; // Second the count belongs to
+    std::atomic<unsigned int> count;
+    std::atomic<unsigned int> skipped;
+};
+
+struct LogRecord {
+    LogLevel level;
+    std::uint64_t time; // Microseconds since the logger started
+    const char* message;
+    unsigned int suppressed;
+    int fieldCount;
+    LogField fields[LOG_MAX_FIELDS];
+};
+
+// Asynchronous logger. Any thread pushes fixed-size records into a bounded
+// lock-free ring; a background thread formats them and writes stdout
+// (warnings and errors go to stderr), flushing only when it runs out of
+// work. Nothing on the calling thread blocks or allocates. When the ring
+// is full the record is dropped and counted.
+class Logger {
+public:
+    static const std::size_t CAPACITY = 1024; // Records, power of two
+
+    static Logger& instance();
+
+    template <typename... Fields>
+    void log(LogLevel level, LogRateLimit& limit, const char* message, const Fields&... fields) {
+        static_assert(sizeof...(Fields) <= LOG_MAX_FIELDS, "too many log fields");
+        if (level < minLevel.load(std::memory_order_relaxed)) {
+            return;
+        }
+        unsigned int suppressed = 0;
+        if (!limit.allow(now(), suppressed)) {
+            return;
+        }
+        // Leading empty field so an empty pack still makes a valid array
+        const LogField list[] = { LogField(), LogField(fields)... };
+        push(level, message, suppressed, list + 1, static_cast<int>(sizeof...(Fields)));
+    }
+
+    // Runtime filter on top of LOG_MIN_LEVEL
+    void setMinLevel(LogLevel level);
+    // Block until everything logged so far was written
+    void flush();
+
+    std::uint64_t getDroppedCount() const;
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    Logger();
+    ~Logger(); // Writes what is left
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    std::uint64_t now() const;
+    void push(LogLevel level, const char* message, unsigned int suppressed, const LogField* fields, int fieldCount);
+    bool pop(LogRecord& record);
+    void run();
+    void write(const LogRecord& record);
+
+    std::unique_ptr<Cell[]> cells;
+    std::atomic<std::size_t> enqueuePosition;
+    std::size_t dequeuePosition; // Writer thread only
+    std::atomic<std::size_t> written; // Records written and flushed, or dropped
+    std::atomic<std::uint64_t> dropped;
+    std::atomic<int> minLevel;
+    std::atomic<bool> running;
+    std::uint64_t startTime;
+    std::thread thread;
+};
+
+#define LOG_AT(level, ...)                                            \
+    do {                                                              \
+        static LogRateLimit logRateLimit;                             \
+        Logger::instance().log(level, logRateLimit, __VA_ARGS__);     \
+    } while (0)
+
+#if LOG_MIN_LEVEL <= 0
+#define LOG_TRACE(...) LOG_AT(LOG_LEVEL_TRACE, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_DEBUG(...) LOG_AT(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_INFO(...) LOG_AT(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_MIN_LEVEL <= 3
+#define LOG_WARN(...) LOG_AT(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#define LOG_ERROR(...) LOG_AT(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // LOG_H
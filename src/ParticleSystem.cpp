@@ -0,0 +1,253 @@
+#include "ParticleSystem.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float PI = 3.14159265f;
+const std::uint64_t PARTICLE_SEED = 0x9e3779b97f4a7c15ULL;
+
+// Indexed by GameEffect. Gunfire and blood share a budget of 100000 live
+// particles, the grenade effects have their own on top of it.
+const EmitterDefinition EMITTERS[EFFECT_COUNT] = {
+    // Muzzle flash: a short bright puff out of the barrel, the strip's flash frame
+    { 4096, 6, 40.0f, 120.0f, 0.0f, 0.35f, 0.0f, 8.0f, 0.06f, 0.12f, 48.0f, 96.0f, 3, 3,
+      sf::Color(255, 240, 160, 255), sf::Color(255, 140, 40, 0) },
+    // Blood: carries on along the bullet and falls, tinted fireball blobs
+    { 49152, 12, 120.0f, 320.0f, 0.0f, 0.6f, 900.0f, 2.0f, 0.3f, 0.6f, 24.0f, 48.0f, 4, 5,
+      sf::Color(170, 0, 0, 255), sf::Color(90, 0, 0, 0) },
+    // Blood burst: a zombie going down, mostly upwards
+    { 49152, 40, 80.0f, 360.0f, -PI / 2.0f, 2.5f, 900.0f, 1.5f, 0.5f, 1.0f, 32.0f, 72.0f, 4, 5,
+      sf::Color(150, 0, 0, 255), sf::Color(60, 0, 0, 0) },
+    // Explosion: a single fireball playing out the strip where the grenade went off
+    { 256, 1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.6f, 0.6f, 384.0f, 384.0f, 3, 8,
+      sf::Color(255, 255, 255, 255), sf::Color(255, 255, 255, 160) },
+    // Debris: smoke thrown up and out of the fireball
+    { 8192, 24, 100.0f, 380.0f, -PI / 2.0f, 1.3f, 500.0f, 1.5f, 0.5f, 1.0f, 64.0f, 128.0f, 6, 8,
+      sf::Color(220, 220, 220, 255), sf::Color(80, 80, 80, 0) }
+};
+
+const int MAX_EFFECT_FRAMES = 16; // Longest effect animation buildVertices plays
+
+// One frame of an effect, looked up once per effect instead of per particle
+struct FrameQuad {
+    bool onPage;
+    float left; // Trimmed rectangle inside the cell, in cells
+    float top;
+    float right;
+    float bottom;
+    sf::Vector2f texCoords[4]; // Top left, top right, bottom right, bottom left
+};
+
+} // namespace
+
+const EmitterDefinition& getEmitterDefinition(GameEffect effect) {
+    return EMITTERS[effect];
+}
+
+ParticleSystem::ParticleSystem() :
+    random(PARTICLE_SEED),
+    dropped(0)
+{
+    // Every pool is allocated once at its full size
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        Pool& pool = pools[i];
+        std::size_t capacity = EMITTERS[i].capacity;
+        pool.count = 0;
+        pool.posX.resize(capacity);
+        pool.posY.resize(capacity);
+        pool.velX.resize(capacity);
+        pool.velY.resize(capacity);
+        pool.age.resize(capacity);
+        pool.inverseLifetime.resize(capacity);
+        pool.size.resize(capacity);
+
+        // Fade from the start to the end colour, sampled in the middle of each step
+        const EmitterDefinition& definition = EMITTERS[i];
+        for (int step = 0; step < FADE_STEPS; step++) {
+            float progress = (step + 0.5f) / FADE_STEPS;
+            fadeColors[i][step] = sf::Color(
+                static_cast<sf::Uint8>(definition.colorStart.r + (definition.colorEnd.r - definition.colorStart.r) * progress),
+                static_cast<sf::Uint8>(definition.colorStart.g + (definition.colorEnd.g - definition.colorStart.g) * progress),
+                static_cast<sf::Uint8>(definition.colorStart.b + (definition.colorEnd.b - definition.colorStart.b) * progress),
+                static_cast<sf::Uint8>(definition.colorStart.a + (definition.colorEnd.a - definition.colorStart.a) * progress));
+        }
+    }
+}
+
+void ParticleSystem::emit(const EffectEvent& effect) {
+    const EmitterDefinition& definition = EMITTERS[effect.effect];
+    Pool& pool = pools[effect.effect];
+
+    int spawned = std::min(definition.burstCount, definition.capacity - pool.count);
+    dropped += definition.burstCount - spawned;
+
+    // Mirrored for effects facing left
+    float direction = effect.facingRight ? definition.direction : PI - definition.direction;
+    for (int n = 0; n < spawned; n++) {
+        int i = pool.count++;
+        float angle = direction + random.nextFloat(-definition.spread, definition.spread);
+        float speed = random.nextFloat(definition.speedMin, definition.speedMax);
+        pool.posX[i] = effect.position.x;
+        pool.posY[i] = effect.position.y;
+        pool.velX[i] = std::cos(angle) * speed;
+        pool.velY[i] = std::sin(angle) * speed;
+        pool.age[i] = 0.0f;
+        pool.inverseLifetime[i] = 1.0f / random.nextFloat(definition.lifetimeMin, definition.lifetimeMax);
+        pool.size[i] = random.nextFloat(definition.sizeMin, definition.sizeMax);
+    }
+}
+
+void ParticleSystem::emit(const std::vector<EffectEvent>& effects) {
+    for (const EffectEvent& effect : effects) {
+        emit(effect);
+    }
+}
+
+void ParticleSystem::update(float deltaTime) {
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        updatePool(pools[i], EMITTERS[i], deltaTime);
+    }
+}
+
+void ParticleSystem::updatePool(Pool& pool, const EmitterDefinition& definition, float deltaTime) {
+    const std::size_t count = pool.count;
+    float* x = pool.posX.data();
+    float* y = pool.posY.data();
+    float* vx = pool.velX.data();
+    float* vy = pool.velY.data();
+    float* age = pool.age.data();
+    const float damping = std::max(0.0f, 1.0f - definition.drag * deltaTime);
+    const float fall = definition.gravity * deltaTime;
+
+    // Straight loops over plain floats so the compiler can vectorize them
+    for (std::size_t i = 0; i < count; i++) {
+        vx[i] *= damping;
+        vy[i] = vy[i] * damping + fall;
+        x[i] += vx[i] * deltaTime;
+        y[i] += vy[i] * deltaTime;
+        age[i] += deltaTime;
+    }
+
+    // Swap the last live particle into every expired one
+    const float* inverseLifetime = pool.inverseLifetime.data();
+    for (std::size_t i = 0; i < static_cast<std::size_t>(pool.count); /* no increment */) {
+        if (age[i] * inverseLifetime[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        int last = --pool.count;
+        pool.posX[i] = pool.posX[last];
+        pool.posY[i] = pool.posY[last];
+        pool.velX[i] = pool.velX[last];
+        pool.velY[i] = pool.velY[last];
+        pool.age[i] = pool.age[last];
+        pool.inverseLifetime[i] = pool.inverseLifetime[last];
+        pool.size[i] = pool.size[last];
+    }
+}
+
+void ParticleSystem::clear() {
+    for (Pool& pool : pools) {
+        pool.count = 0;
+    }
+}
+
+std::size_t ParticleSystem::buildVertices(const AtlasClip& clip, const sf::Texture* page, sf::Vertex* out) const {
+    const int frameCount = static_cast<int>(clip.frames.size());
+    if (frameCount == 0) {
+        return 0;
+    }
+
+    sf::Vertex* const begin = out;
+    FrameQuad quads[MAX_EFFECT_FRAMES];
+
+    for (int effect = 0; effect < EFFECT_COUNT; effect++) {
+        const EmitterDefinition& definition = EMITTERS[effect];
+        const Pool& pool = pools[effect];
+        if (pool.count == 0) {
+            continue;
+        }
+        const int firstFrame = std::min(definition.firstFrame, frameCount - 1);
+        const int frameSpan = std::min(std::min(definition.lastFrame, frameCount - 1) - firstFrame + 1, MAX_EFFECT_FRAMES);
+
+        for (int f = 0; f < frameSpan; f++) {
+            const AtlasFrame& frame = clip.frames[firstFrame + f];
+            FrameQuad& quad = quads[f];
+            quad.onPage = frame.texture == page;
+            // Centered on the particle; the effect art sits at the bottom of
+            // its cell, so keeping the cell offset would drop it below the spawn point
+            float halfWidth = static_cast<float>(frame.rect.width) / SpriteAtlas::FRAME_SIZE / 2.0f;
+            float halfHeight = static_cast<float>(frame.rect.height) / SpriteAtlas::FRAME_SIZE / 2.0f;
+            quad.left = -halfWidth;
+            quad.top = -halfHeight;
+            quad.right = halfWidth;
+            quad.bottom = halfHeight;
+            float u0 = static_cast<float>(frame.rect.left);
+            float v0 = static_cast<float>(frame.rect.top);
+            float u1 = u0 + frame.rect.width;
+            float v1 = v0 + frame.rect.height;
+            quad.texCoords[0] = sf::Vector2f(u0, v0);
+            quad.texCoords[1] = sf::Vector2f(u1, v0);
+            quad.texCoords[2] = sf::Vector2f(u1, v1);
+            quad.texCoords[3] = sf::Vector2f(u0, v1);
+        }
+
+        // Frame and faded colour per progress step, looked up per particle
+        // instead of lerped
+        const FrameQuad* stepQuads[FADE_STEPS];
+        const sf::Color* stepColors = fadeColors[effect];
+        for (int step = 0; step < FADE_STEPS; step++) {
+            stepQuads[step] = &quads[step * frameSpan / FADE_STEPS];
+        }
+
+        const float* posX = pool.posX.data();
+        const float* posY = pool.posY.data();
+        const float* age = pool.age.data();
+        const float* inverseLifetime = pool.inverseLifetime.data();
+        const float* sizes = pool.size.data();
+        for (int i = 0; i < pool.count; i++) {
+            int step = std::min(static_cast<int>(age[i] * inverseLifetime[i] * FADE_STEPS), FADE_STEPS - 1);
+            const FrameQuad& quad = *stepQuads[step];
+            if (!quad.onPage) {
+                continue;
+            }
+
+            // Trimmed frames keep their scale relative to the cell
+            const float size = sizes[i];
+            const float left = posX[i] + quad.left * size;
+            const float top = posY[i] + quad.top * size;
+            const float right = posX[i] + quad.right * size;
+            const float bottom = posY[i] + quad.bottom * size;
+            const sf::Color color = stepColors[step];
+
+            // Each vertex written whole, in one pass
+            out[0] = sf::Vertex(sf::Vector2f(left, top), color, quad.texCoords[0]);
+            out[1] = sf::Vertex(sf::Vector2f(right, top), color, quad.texCoords[1]);
+            out[2] = sf::Vertex(sf::Vector2f(right, bottom), color, quad.texCoords[2]);
+            out[3] = sf::Vertex(sf::Vector2f(left, bottom), color, quad.texCoords[3]);
+            out += 4;
+        }
+    }
+    return out - begin;
+}
+
+int ParticleSystem::getLiveCount() const {
+    int count = 0;
+    for (const Pool& pool : pools) {
+        count += pool.count;
+    }
+    return count;
+}
+
+int ParticleSystem::getCapacity() const {
+    int capacity = 0;
+    for (int i = 0; i < EFFECT_COUNT; i++) {
+        capacity += EMITTERS[i].capacity;
+    }
+    return capacity;
+}
+
+unsigned int ParticleSystem::getDroppedCount() const {
+    return dropped;
+}
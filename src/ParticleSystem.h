@@ -0,0 +1,81 @@
+#ifndef PARTICLESYSTEM_H
+#define PARTICLESYSTEM_H
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <vector>
+#include "GameEvents.h"
+#include "GameRandom.h"
+#include "SpriteAtlas.h"
+
+// How one kind of effect spawns and moves. Every particle is a frame of the
+// effect strip (Player/Explosion) centered on it, tinted and faded over its
+// lifetime.
+struct EmitterDefinition {
+    int capacity;   // Live particles of this kind, more are dropped
+    int burstCount; // Particles per effect event
+    float speedMin;
+    float speedMax;
+    float direction; // Radians, 0 points the way the effect faces, y grows down
+    float spread;    // Random offset from direction, either way
+    float gravity;   // Pixels per second squared
+    float drag;      // Fraction of the velocity lost per second
+    float lifetimeMin;
+    float lifetimeMax;
+    float sizeMin; // World pixels covered by the whole animation cell
+    float sizeMax;
+    int firstFrame; // Strip frames played over the lifetime
+    int lastFrame;
+    sf::Color colorStart;
+    sf::Color colorEnd;
+};
+
+const EmitterDefinition& getEmitterDefinition(GameEffect effect);
+
+// Cosmetic particles for the effects raised by the simulation. Each effect
+// kind has a fixed capacity pool stored as parallel arrays, so update() is
+// a few straight loops over floats and never allocates. Not part of the
+// simulation state: particles use their own random numbers and may differ
+// between a run and its replay.
+class ParticleSystem {
+public:
+    ParticleSystem();
+
+    void emit(const EffectEvent& effect);
+    void emit(const std::vector<EffectEvent>& effects);
+    void update(float deltaTime);
+    void clear();
+
+    // Write a quad (sf::Quads order) per live particle whose frame of the
+    // strip lies on page, so each atlas page is one batch. out needs room for
+    // four vertices per live particle; returns the number written.
+    std::size_t buildVertices(const AtlasClip& clip, const sf::Texture* page, sf::Vertex* out) const;
+
+    int getLiveCount() const;
+    int getCapacity() const;
+    unsigned int getDroppedCount() const; // Not spawned because the pool was full
+
+private:
+    static const int FADE_STEPS = 256; // Progress steps of the fade table, a colour channel's resolution
+
+    // Structure of arrays, live particles packed into [0, count)
+    struct Pool {
+        int count;
+        std::vector<float> posX;
+        std::vector<float> posY;
+        std::vector<float> velX;
+        std::vector<float> velY;
+        std::vector<float> age;
+        std::vector<float> inverseLifetime; // Age times this is the 0 to 1 progress
+        std::vector<float> size;
+    };
+
+    void updatePool(Pool& pool, const EmitterDefinition& definition, float deltaTime);
+
+    Pool pools[EFFECT_COUNT];
+    sf::Color fadeColors[EFFECT_COUNT][FADE_STEPS]; // Faded colour per progress step, built once
+    GameRandom random;
+    unsigned int dropped;
+};
+
+#endif // PARTICLESYSTEM_H
@@ -1,13 +1,22 @@
 #include "Player.h"
 #include "Hitbox.h"
-#include <iostream>
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const float CELL_SIZE = 128.0f;      // Untrimmed animation cell, see SpriteAtlas::FRAME_SIZE
+const float SPRITE_SCALE = 3.0f;
+const float RELOAD_DURATION = 2.45f; // Length of Assets/reload.mp3
+const float WORLD_MARGIN = 100.0f;   // Closest the player gets to either end of the level
+const int THROW_RELEASE_FRAME = 6;   // Arm forward in the grenade animation
+
+} // namespace
 
 Player::Player() :
-    frameCount(6),
-    currentFrame(0),
-    frameDuration(0.10f),
-    frameTimer(0.0f),
     speed(300.0f),
+    worldWidth(1280.0f),
     isRunning(false),
     facingRight(true),
     isShooting(false),
@@ -15,8 +24,11 @@ Player::Player() :
     isReloading(false),
     reloadingTimer(0.0f),
     reloadKeyPressed(false),
+    isThrowing(false),
+    releasingGrenade(false),
+    throwingTimer(0.0f),
     isDead(false), // Initialize death state
-    hitbox(sf::Vector2f(100.0f, 164.0f)),
+    hitbox(sf::Vector2f(100.0f, 164.0f), HITBOX_LAYER_PLAYER, HITBOX_LAYER_ENEMY),
     health(100.0f), // Initialize health
     invulnerabilityTimer(0.0f), // Initialize invulnerability timer
     deathAnimationTimer(0.0f) // Initialize death animation timer
@@ -24,135 +36,83 @@ Player::Player() :
 }
 
 void Player::init() {
-    if (!idleTexture.loadFromFile("Assets/Player/Idle.png")) {
-        std::cerr << "Error loading idle texture" << std::endl;
-        return;
-    }
-    if (!runTexture.loadFromFile("Assets/Player/Run.png")) {
-        std::cerr << "Error loading run texture" << std::endl;
-        return;
-    }
-    if (!shootTexture.loadFromFile("Assets/Player/Shot_2.png")) {
-        std::cerr << "Error loading shoot texture" << std::endl;
-        return;
-    }
-    if (!reloadTexture.loadFromFile("Assets/Player/Recharge.png")) {
-        std::cerr << "Error loading reload texture" << std::endl;
-        return;
-    }
-    if (!deathTexture.loadFromFile("Assets/Player/Dead.png")) { // Load death texture
-        std::cerr << "Error loading death texture" << std::endl;
-        return;
-    }
-
-    // Set the origin to center of 128x128 texture before scaling
-    playerSprite.setOrigin(64.f, 64.f); // Center of the sprite (128 / 2)
-
-    // Scale and position the sprite
-    playerSprite.setScale(3.0f, 3.0f);
-    playerSprite.setPosition(400, 300 + 128.0f * 3.0f / 2.0f); // This sets his feet to the ground
-
-    // Initialize animation frame rectangles
-    idleFrameRect = sf::IntRect(0, 0, 128, 128);
-    runFrameRect = sf::IntRect(0, 0, 128, 128);
-    shootFrameRect = sf::IntRect(0, 0, 128, 128);
-    reloadFrameRect = sf::IntRect(0, 0, 128, 128);
-    deathFrameRect = sf::IntRect(0, 0, 128, 128); // Initialize death frame rectangle
-    playerSprite.setTexture(idleTexture);
-    playerSprite.setTextureRect(idleFrameRect);
-
-    // Load sounds
-    if (!shootSoundBuffer.loadFromFile("Assets/shoot.mp3")) {
-        std::cerr << "Error loading shoot sound" << std::endl;
-    } else {
-        shootSound.setBuffer(shootSoundBuffer);
-    }
- 
-     if (!reloadSoundBuffer.loadFromFile("Assets/reload.mp3")) {
-         std::cerr << "Error loading reload sound" << std::endl;
-         } else {
-         reloadSound.setBuffer(reloadSoundBuffer);
-         }
- 
-    // Load death sound
-    if (!deathSoundBuffer.loadFromFile("Assets/playerdeath.mp3")) {
-        std::cerr << "Error loading death sound" << std::endl;
-    } else {
-        deathSound.setBuffer(deathSoundBuffer);
-    }
+    // Position the player
+    position = sf::Vector2f(400, 300 + CELL_SIZE * SPRITE_SCALE / 2.0f); // This sets his feet to the ground
+    previousPosition = position;
+    animation.restart(CLIP_PLAYER_IDLE);
 
      // Position hitbox at same center
-    hitbox.setPosition(playerSprite.getPosition().x, playerSprite.getPosition().y + 128.0f * 3.0f / 2.0f);
+    hitbox.setPosition(position.x, position.y + CELL_SIZE * SPRITE_SCALE / 2.0f);
 }
 
-void Player::update(float deltaTime) {
+void Player::setWorldWidth(float width) {
+    worldWidth = width;
+    float clamped = std::min(std::max(position.x, WORLD_MARGIN), worldWidth - WORLD_MARGIN);
+    if (clamped != position.x) {
+        position.x = clamped;
+        previousPosition.x = clamped;
+        hitbox.setPosition(position.x, position.y + CELL_SIZE / 2.0f);
+    }
+}
+
+void Player::update(float deltaTime, const InputState& input, GameEvents& events) {
+    previousPosition = position;
+    releasingGrenade = false;
+
     if (!isAlive() && !isDead) { // Check if player just died
         setDeathAnimation(true);
+        events.playSound(SOUND_PLAYER_DEATH, position); // Play death sound
         deathAnimationTimer = 0.0f; // Start the death animation timer
     }
 
     if (isDead) {
         deathAnimationTimer += deltaTime; // Increment death animation timer
-        // Update death animation frames
-        frameTimer += deltaTime;
-        if (frameTimer >= frameDuration) {
-            frameTimer = 0.0f;
-            currentFrame = (currentFrame + 1); // Don't loop death animation
-            if (currentFrame >= frameCount) {
-                currentFrame = frameCount - 1; // Hold on last frame
-            }
-        }
-        deathFrameRect.left = currentFrame * 128;
-        playerSprite.setTextureRect(deathFrameRect);
+        animation.update(deltaTime); // Holds on the last frame
         return; // Stop updating other animations and movement if dead
     }
 
     bool moving = false;
-    sf::Vector2f currentPosition = playerSprite.getPosition();
-    float leftBounds = 100; // Expanded left barrier
-    float rightBounds = 1280 - 100; // Expanded right barrier
+    float leftBounds = WORLD_MARGIN;
+    float rightBounds = worldWidth - WORLD_MARGIN;
 
     // Moving logic for A and D keys
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
-        if (currentPosition.x > leftBounds) {
-            playerSprite.move(-speed * deltaTime, 0);
+    if (input.moveLeft) {
+        if (position.x > leftBounds) {
+            position.x -= speed * deltaTime;
             moving = true;
         }
-        if (facingRight) {
-            facingRight = false;
-            playerSprite.setScale(-3.0f, 3.0f);  // Flip the sprite without moving it
-        }
+        facingRight = false;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
-        if (currentPosition.x < rightBounds) {
-            playerSprite.move(speed * deltaTime, 0);
+    if (input.moveRight) {
+        if (position.x < rightBounds) {
+            position.x += speed * deltaTime;
             moving = true;
         }
-        if (!facingRight) {
-            facingRight = true;
-            playerSprite.setScale(3.0f, 3.0f);  // Flip the sprite without moving it
-        }
+        facingRight = true;
     }
 
-    setRunningAnimation(moving);
+    isRunning = moving;
 
     // Handle shooting key
-    if (isReloading) {
-        // Do nothing if reloading
+    if (isReloading || isThrowing) {
+        // Do nothing if reloading or throwing
         }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space)) {
+        else if (input.shoot) {
             if (!isShooting) {
-                setShootingAnimation(true);
-                shootSound.play();
+                isShooting = true;
+                shootingTimer = 0.0f;
+                events.playSound(SOUND_SHOOT, position);
             }
         }
 
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::R) && !reloadKeyPressed && !isReloading) {
-        setReloadingAnimation(true);
+    if (input.reload && !reloadKeyPressed && !isReloading && !isThrowing) {
+        isReloading = true;
+        isShooting = false;
         reloadKeyPressed = true;
-        reloadSound.play();
+        reloadingTimer = 0.0f;
+        events.playSound(SOUND_RELOAD, position);
     }
-    if (!sf::Keyboard::isKeyPressed(sf::Keyboard::R)) {
+    if (!input.reload) {
         reloadKeyPressed = false;
     }
 
@@ -161,103 +121,69 @@ void Player::update(float deltaTime) {
         shootingTimer += deltaTime;
         if (shootingTimer > 0.2f) {
             shootingTimer = 0.0f;
-            setShootingAnimation(false);
+            isShooting = false;
         }
     }
 
+    // Reloading lasts as long as the reload sound
     if (isReloading) {
-        if (reloadSound.getStatus() == sf::Sound::Stopped) {
-            setReloadingAnimation(false);
+        reloadingTimer += deltaTime;
+        if (reloadingTimer >= RELOAD_DURATION) {
+            isReloading = false;
+        }
+    }
+
+    // The grenade leaves the hand partway through the throw
+    if (isThrowing) {
+        const AnimationClip& clip = getAnimationClip(CLIP_PLAYER_THROW);
+        float releaseTime = THROW_RELEASE_FRAME * clip.frameDuration;
+        releasingGrenade = throwingTimer < releaseTime && throwingTimer + deltaTime >= releaseTime;
+        throwingTimer += deltaTime;
+        if (throwingTimer >= clip.getLength()) {
+            isThrowing = false;
         }
     }
 
     // Update invulnerability timer if active
     if (invulnerabilityTimer > 0) {
         invulnerabilityTimer -= deltaTime;
-        
-        // Make the sprite flash when invulnerable
-        // Make the sprite flash when invulnerable
-        if (static_cast<int>(invulnerabilityTimer * 10) % 2 == 0) {
-            playerSprite.setColor(sf::Color(255, 255, 255, 128)); // Half transparent
-        } else {
-            playerSprite.setColor(sf::Color(255, 255, 255, 255)); // Fully visible
-        }
-    } else {
-        playerSprite.setColor(sf::Color(255, 255, 255, 255)); // Ensure full visibility
     }
 
-    // Animate
-    frameTimer += deltaTime;
-    if (frameTimer >= frameDuration) {
-        frameTimer = 0.0f;
-        currentFrame = (currentFrame + 1) % frameCount;
-    }
+    // Animate, a new clip starts from its first frame
+    animation.play(selectAnimation());
+    animation.update(deltaTime);
 
     // Update hitbox position to match sprite's position + adjusted for sprite height
-    hitbox.setPosition(playerSprite.getPosition().x, playerSprite.getPosition().y + playerSprite.getLocalBounds().height / 2.0f);
-
-    // Decide which frameRect to use
-    sf::IntRect* currentRect;
-    if (isDead) { // Prioritize death animation
-        currentRect = &deathFrameRect;
-    }
-    else if (isShooting) {
-        currentRect = &shootFrameRect;
-    }
-    else if (isReloading) {
-        currentRect = &reloadFrameRect;
-    }
-    else if (isRunning) {
-        currentRect = &runFrameRect;
-    }
-    else {
-        currentRect = &idleFrameRect;
-    }
-
-    currentRect->left = currentFrame * 128;
-    playerSprite.setTextureRect(*currentRect);
+    hitbox.setPosition(position.x, position.y + CELL_SIZE / 2.0f);
 }
 
-void Player::setRunningAnimation(bool isRunning) {
-    if (this->isRunning != isRunning) {
-        this->isRunning = isRunning;
-        if (isRunning) {
-            playerSprite.setTexture(runTexture);
-            frameCount = 6;
-            frameDuration = 0.08f;
-        }
-        else {
-            playerSprite.setTexture(idleTexture);
-            frameCount = 4;
-            frameDuration = 0.15f;
-        }
-        currentFrame = 0;
+AnimationClipId Player::selectAnimation() const {
+    if (isDead) {
+        return CLIP_PLAYER_DEAD;
     }
-    else if (isShooting) {
-        return;
+    if (isReloading) {
+        return CLIP_PLAYER_RELOAD;
     }
-    else if (isReloading) {
-        return;
+    if (isThrowing) {
+        return CLIP_PLAYER_THROW;
     }
+    if (isShooting) {
+        return CLIP_PLAYER_SHOOT;
+    }
+    return isRunning ? CLIP_PLAYER_RUN : CLIP_PLAYER_IDLE;
 }
 
-void Player::draw(sf::RenderWindow& window) {
-    window.draw(playerSprite);
-
-    // Draw hitbox for debugging
-    // hitbox.draw(window);
-}
-
-sf::Sprite& Player::getSprite() {
-    return playerSprite;
+sf::Vector2f Player::getPosition() const {
+    return position;
 }
 
-sf::Vector2f Player::getPosition() const {
-    return playerSprite.getPosition();
+sf::Vector2f Player::getPreviousPosition() const {
+    return previousPosition;
 }
 
 sf::Vector2f Player::getSize() const {
-    return sf::Vector2f(playerSprite.getGlobalBounds().width, playerSprite.getGlobalBounds().height);
+    // Size of the untrimmed cell, so trimmed atlas frames don't move the muzzle
+    return sf::Vector2f(CELL_SIZE * SPRITE_SCALE, CELL_SIZE * SPRITE_SCALE);
 }
 
 bool Player::isFacingRight() const {
@@ -268,70 +194,54 @@ bool Player::getIsReloading() const {
     return isReloading;
 }
 
-void Player::setShootingAnimation(bool isShooting) {
-    if (isReloading) {
-        return;
-    }
-    if (this->isShooting != isShooting) {
-        this->isShooting = isShooting;
-        if (isShooting) {
-            playerSprite.setTexture(shootTexture);
-            frameCount = 2;
-            frameDuration = 0.1f;
-        }
-        else {
-            if (isRunning) {
-                playerSprite.setTexture(runTexture);
-                frameCount = 6;
-                frameDuration = 0.08f;
-            }
-            else {
-                playerSprite.setTexture(idleTexture);
-                frameCount = 4;
-                frameDuration = 0.15f;
-            }
-        }
-        currentFrame = 0;
+bool Player::startThrow() {
+    if (isDead || isReloading || isThrowing) {
+        return false;
     }
+    isThrowing = true;
+    isShooting = false;
+    throwingTimer = 0.0f;
+    return true;
 }
 
-void Player::setReloadingAnimation(bool isReloading) {
-    if (this->isReloading != isReloading) {
-        this->isReloading = isReloading;
-        if (isReloading) {
-            playerSprite.setTexture(reloadTexture);
-            frameCount = 4;
-            frameDuration = 0.1f;
-        }
-        else {
-            if (isRunning) {
-                playerSprite.setTexture(runTexture);
-                frameCount = 6;
-                frameDuration = 0.08f;
-            }
-            else {
-                playerSprite.setTexture(idleTexture);
-                frameCount = 4;
-                frameDuration = 0.15f;
-            }
-        }
-        currentFrame = 0;
-    }
+bool Player::getIsThrowing() const {
+    return isThrowing;
+}
+
+bool Player::isReleasingGrenade() const {
+    return releasingGrenade;
+}
+
+sf::Vector2f Player::getGrenadeOrigin() const {
+    // Hand at the top of the swing, a little ahead of the body
+    float offsetX = CELL_SIZE * SPRITE_SCALE * 0.25f;
+    return sf::Vector2f(position.x + (facingRight ? offsetX : -offsetX), position.y);
+}
+
+AnimationClipId Player::getAnimation() const {
+    return animation.getClip();
+}
+
+int Player::getCurrentFrame() const {
+    return animation.getFrame();
+}
+
+bool Player::isFlashing() const {
+    // Make the sprite flash when invulnerable
+    return invulnerabilityTimer > 0 && static_cast<int>(invulnerabilityTimer * 10) % 2 == 0;
 }
 
 void Player::setDeathAnimation(bool isDead) {
     if (this->isDead != isDead) {
         this->isDead = isDead;
         if (isDead) {
-            playerSprite.setTexture(deathTexture);
-            frameCount = 4; // Assuming 4 frames for death animation
-            frameDuration = 0.15f; // Adjust duration as needed
-           deathSound.play(); // Play death sound
-            currentFrame = 0;
+            animation.restart(CLIP_PLAYER_DEAD);
             // Stop other animations
             isRunning = false;
             isShooting = false;
             isReloading = false;
+            isThrowing = false;
+            releasingGrenade = false;
         }
     }
 }
@@ -345,7 +255,7 @@ void Player::takeDamage(float damage) {
         // Set invulnerability for 1 second
         invulnerabilityTimer = 1.0f;
         
-        std::cout << "Player took " << damage << " damage. Health: " << health << std::endl;
+        LOG_DEBUG("Player took damage", LogField("damage", damage), LogField("health", health));
     }
 }
 
@@ -358,11 +268,59 @@ bool Player::isAlive() const {
 }
 
 bool Player::isDeathAnimationComplete() const {
-    // Assuming death animation has 4 frames and frameDuration is 0.15f
-    // The total duration of the death animation is frameCount * frameDuration
-    return isDead && deathAnimationTimer >= (frameCount * frameDuration);
+    return isDead && deathAnimationTimer >= getAnimationClip(CLIP_PLAYER_DEAD).getLength();
 }
 
 Hitbox& Player::getHitbox() {
     return hitbox;
 }
+
+const Hitbox& Player::getHitbox() const {
+    return hitbox;
+}
+
+void Player::saveState(StateWriter& writer) const {
+    writer.write(position);
+    writer.write(previousPosition);
+    animation.saveState(writer);
+    hitbox.saveState(writer);
+    writer.write(speed);
+    writer.write(worldWidth);
+    writer.write(isRunning);
+    writer.write(facingRight);
+    writer.write(isShooting);
+    writer.write(isReloading);
+    writer.write(reloadKeyPressed);
+    writer.write(isThrowing);
+    writer.write(releasingGrenade);
+    writer.write(shootingTimer);
+    writer.write(reloadingTimer);
+    writer.write(throwingTimer);
+    writer.write(isDead);
+    writer.write(health);
+    writer.write(invulnerabilityTimer);
+    writer.write(deathAnimationTimer);
+}
+
+void Player::loadState(StateReader& reader) {
+    reader.read(position);
+    reader.read(previousPosition);
+    animation.loadState(reader);
+    hitbox.loadState(reader);
+    reader.read(speed);
+    reader.read(worldWidth);
+    reader.read(isRunning);
+    reader.read(facingRight);
+    reader.read(isShooting);
+    reader.read(isReloading);
+    reader.read(reloadKeyPressed);
+    reader.read(isThrowing);
+    reader.read(releasingGrenade);
+    reader.read(shootingTimer);
+    reader.read(reloadingTimer);
+    reader.read(throwingTimer);
+    reader.read(isDead);
+    reader.read(health);
+    reader.read(invulnerabilityTimer);
+    reader.read(deathAnimationTimer);
+}
@@ -1,70 +1,76 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
+#include <SFML/System/Vector2.hpp>
+#include "Animation.h"
 #include "Hitbox.h"
+#include "GameInput.h"
+#include "GameEvents.h"
+#include "StateStream.h"
 
 class Player {
 public:
     Player();
 
     void init();
-    void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
-    sf::Sprite& getSprite();
+    // Keeps the player inside a level of this width, moving them in if needed
+    void setWorldWidth(float width);
+    void update(float deltaTime, const InputState& input, GameEvents& events);
     sf::Vector2f getPosition() const;
+    sf::Vector2f getPreviousPosition() const; // Position at the start of the last tick, for interpolation
     sf::Vector2f getSize() const;
     bool isFacingRight() const;
     bool getIsReloading() const; // Added missing declaration
 
+    // Grenade throws. startThrow plays the throw unless the player is busy;
+    // the grenade leaves the hand a few frames in, on the tick where
+    // isReleasingGrenade is true, from getGrenadeOrigin.
+    bool startThrow();
+    bool getIsThrowing() const;
+    bool isReleasingGrenade() const;
+    sf::Vector2f getGrenadeOrigin() const;
+
+    // State read by the renderer
+    AnimationClipId getAnimation() const;
+    int getCurrentFrame() const;
+    bool isFlashing() const; // Drawn half transparent while invulnerable
+
     // New methods for health and combat
     Hitbox& getHitbox(); // Added missing declaration
+    const Hitbox& getHitbox() const;
     void takeDamage(float damage);
     float getHealth() const;
     bool isAlive() const;
     void setDeathAnimation(bool isDead); // Added death animation method
     bool isDeathAnimationComplete() const; // Added method to check if death animation is complete
 
-private:
-    void setRunningAnimation(bool isRunning);
-    void setShootingAnimation(bool isShooting);
-    void setReloadingAnimation(bool isReloading);
+    // Replay keyframes
+    void saveState(StateWriter& writer) const;
+    void loadState(StateReader& reader);
 
-    sf::Sprite playerSprite;
-    sf::Texture idleTexture;
-    sf::Texture runTexture;
-    sf::Texture shootTexture;
-    sf::Texture reloadTexture;
-    sf::Texture deathTexture; // Added death texture
+private:
+    // Clip for the current state, dying beats reloading beats throwing beats
+    // shooting beats running
+    AnimationClipId selectAnimation() const;
 
-    sf::IntRect idleFrameRect;
-    sf::IntRect runFrameRect;
-    sf::IntRect shootFrameRect;
-    sf::IntRect reloadFrameRect;
-    sf::IntRect deathFrameRect; // Added death frame rectangle
+    sf::Vector2f position; // Center of the untrimmed animation cell
+    sf::Vector2f previousPosition; // Position at the start of the last tick, for interpolation
+    AnimationPlayer animation;
 
     Hitbox hitbox;  // Custom hitbox for the player
-    sf::SoundBuffer shootSoundBuffer;
-    sf::Sound shootSound;
-    sf::SoundBuffer reloadSoundBuffer;
-    sf::Sound reloadSound;
-    sf::SoundBuffer deathSoundBuffer; // Added death sound buffer
-    sf::Sound deathSound; // Added death sound
-
-    int frameCount;
-    int currentFrame;
-    float frameDuration;
-    float frameTimer;
 
     float speed;
+    float worldWidth;
     bool isRunning;
     bool facingRight;
     bool isShooting;
     bool isReloading;
     bool reloadKeyPressed;
+    bool isThrowing;
+    bool releasingGrenade;
     float shootingTimer;
     float reloadingTimer;
+    float throwingTimer;
     bool isDead; // Added flag for death state
 
     // New member variables for health and invulnerability
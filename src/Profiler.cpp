@@ -0,0 +1,228 @@
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+
+namespace {
+
+const std::chrono::steady_clock::time_point EPOCH = std::chrono::steady_clock::now();
+const double SMOOTHING = 0.05; // Weight of the newest frame in the zone averages
+const char* const FRAME_ZONE = "Frame";
+
+thread_local ProfileRing* currentRing = nullptr;
+
+bool compareStart(const ProfileSample& a, const ProfileSample& b) {
+    return a.start < b.start;
+}
+
+} // namespace
+
+std::atomic<bool> Profiler::enabled(false);
+
+//------------------------------------------------------------------------------
+// ProfileRing Implementation
+//------------------------------------------------------------------------------
+
+ProfileRing::ProfileRing(int thread) :
+    events(new ProfileEvent[CAPACITY]),
+    writeIndex(0),
+    thread(thread)
+{
+    for (std::uint64_t i = 0; i < CAPACITY; i++) {
+        events[i].sequence.store(0, std::memory_order_relaxed);
+    }
+}
+
+void ProfileRing::push(const char* name, std::uint64_t start, std::uint64_t end) {
+    std::uint64_t index = writeIndex.load(std::memory_order_relaxed);
+    ProfileEvent& event = events[index & (CAPACITY - 1)];
+    // Mark the slot as being written before touching the fields
+    event.sequence.store(index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name.store(name, std::memory_order_relaxed);
+    event.start.store(start, std::memory_order_relaxed);
+    event.end.store(end, std::memory_order_relaxed);
+    // Publish the event
+    event.sequence.store(index * 2 + 2, std::memory_order_release);
+    writeIndex.store(index + 1, std::memory_order_release);
+}
+
+std::uint64_t ProfileRing::copy(std::uint64_t from, std::vector<ProfileSample>& samples) const {
+    std::uint64_t end = writeIndex.load(std::memory_order_acquire);
+    std::uint64_t begin = std::max(from, end > CAPACITY ? end - CAPACITY : 0);
+    for (std::uint64_t i = begin; i < end; i++) {
+        const ProfileEvent& event = events[i & (CAPACITY - 1)];
+        const std::uint64_t written = i * 2 + 2;
+        if (event.sequence.load(std::memory_order_acquire) != written) {
+            continue; // The writer lapped us and is writing or has written a newer event here
+        }
+        ProfileSample sample;
+        sample.name = event.name.load(std::memory_order_relaxed);
+        sample.start = event.start.load(std::memory_order_relaxed);
+        sample.end = event.end.load(std::memory_order_relaxed);
+        sample.thread = thread;
+
+        // Only keep the fields if the slot was not rewritten while reading them
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (event.sequence.load(std::memory_order_relaxed) == written) {
+            samples.push_back(sample);
+        }
+    }
+    return end;
+}
+
+//------------------------------------------------------------------------------
+// Profiler Implementation
+//------------------------------------------------------------------------------
+
+Profiler& Profiler::instance() {
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() :
+    wasEnabled(false),
+    frameStart(0),
+    frameCursor(0),
+    frameCount(0)
+{
+    std::fill(frameTimes, frameTimes + FRAME_HISTORY, 0.0f);
+}
+
+void Profiler::setEnabled(bool enabled) {
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::toggle() {
+    setEnabled(!isEnabled());
+}
+
+std::uint64_t Profiler::now() {
+    // Offset by one so a timestamp is never 0, which ProfileZone uses for "not recording"
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - EPOCH).count()) + 1;
+}
+
+ProfileRing& Profiler::threadRing() {
+    if (!currentRing) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(std::unique_ptr<ProfileRing>(new ProfileRing(static_cast<int>(rings.size()))));
+        currentRing = rings.back().get();
+    }
+    return *currentRing;
+}
+
+void Profiler::record(const char* name, std::uint64_t start, std::uint64_t end) {
+    threadRing().push(name, start, end);
+}
+
+void Profiler::endFrame() {
+    // Don't count the time spent disabled as a frame
+    bool enabledNow = isEnabled();
+    if (enabledNow != wasEnabled) {
+        wasEnabled = enabledNow;
+        frameStart = 0;
+    }
+    if (!enabledNow) {
+        return;
+    }
+
+    std::uint64_t frameEnd = now();
+    if (frameStart != 0) {
+        record(FRAME_ZONE, frameStart, frameEnd);
+        frameTimes[frameCursor] = static_cast<float>((frameEnd - frameStart) / 1e6);
+        frameCursor = (frameCursor + 1) % FRAME_HISTORY;
+        frameCount = std::min(frameCount + 1, static_cast<int>(FRAME_HISTORY)); // Copy, min takes a reference
+    }
+    frameStart = frameEnd;
+
+    // Sum this frame's zones of every thread, by name. Zones running on
+    // several threads at once add up, so they can exceed the frame time.
+    frameSamples.clear();
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        readIndices.resize(rings.size(), 0);
+        for (std::size_t i = 0; i < rings.size(); i++) {
+            readIndices[i] = rings[i]->copy(readIndices[i], frameSamples);
+        }
+    }
+    for (ZoneStat& stat : zoneStats) {
+        stat.lastMs = 0.0;
+    }
+    for (const ProfileSample& sample : frameSamples) {
+        if (sample.name == FRAME_ZONE) {
+            continue;
+        }
+        std::vector<ZoneStat>::iterator it = std::find_if(zoneStats.begin(), zoneStats.end(),
+            [&sample](const ZoneStat& stat) { return stat.name == sample.name; });
+        if (it == zoneStats.end()) {
+            ZoneStat stat = { sample.name, 0.0, 0.0 };
+            zoneStats.push_back(stat);
+            it = zoneStats.end() - 1;
+        }
+        it->lastMs += (sample.end - sample.start) / 1e6;
+    }
+    for (ZoneStat& stat : zoneStats) {
+        stat.averageMs += (stat.lastMs - stat.averageMs) * SMOOTHING;
+    }
+}
+
+const std::vector<ZoneStat>& Profiler::getZoneStats() const {
+    return zoneStats;
+}
+
+std::vector<float> Profiler::getFrameHistory() const {
+    std::vector<float> history;
+    history.reserve(frameCount);
+    int first = (frameCursor - frameCount + FRAME_HISTORY) % FRAME_HISTORY;
+    for (int i = 0; i < frameCount; i++) {
+        history.push_back(frameTimes[(first + i) % FRAME_HISTORY]);
+    }
+    return history;
+}
+
+float Profiler::getFramePercentile(float percentile) const {
+    if (frameCount == 0) {
+        return 0.0f;
+    }
+    std::vector<float> sorted(frameTimes, frameTimes + frameCount);
+    std::size_t index = static_cast<std::size_t>(percentile / 100.0f * (frameCount - 1) + 0.5f);
+    std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+    return sorted[index];
+}
+
+bool Profiler::dumpChromeTrace(const std::string& path, double seconds) const {
+    std::vector<ProfileSample> samples;
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        for (const std::unique_ptr<ProfileRing>& ring : rings) {
+            ring->copy(0, samples);
+        }
+    }
+
+    std::uint64_t end = now();
+    std::uint64_t cutoff = end - std::min<std::uint64_t>(end, static_cast<std::uint64_t>(seconds * 1e9));
+    samples.erase(std::remove_if(samples.begin(), samples.end(),
+        [cutoff](const ProfileSample& sample) { return sample.end < cutoff; }), samples.end());
+    std::sort(samples.begin(), samples.end(), compareStart);
+
+    std::ofstream file(path);
+    if (!file) {
+        LOG_ERROR("Failed to write trace", LogField("path", path));
+        return false;
+    }
+    // Trace event format, complete ("X") events with microsecond timestamps
+    file << std::fixed << std::setprecision(3);
+    file << "{\"traceEvents\":[\n";
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        const ProfileSample& sample = samples[i];
+        file << "{\"name\":\"" << sample.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.thread
+             << ",\"ts\":" << sample.start / 1000.0 << ",\"dur\":" << (sample.end - sample.start) / 1000.0 << "}"
+             << (i + 1 < samples.size() ? ",\n" : "\n");
+    }
+    file << "],\"displayTimeUnit\":\"ms\"}\n";
+    LOG_INFO("Wrote profiler trace", LogField("zones", samples.size()), LogField("path", path));
+    return static_cast<bool>(file);
+}
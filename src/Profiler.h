@@ -0,0 +1,143 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// One finished zone. Fields are atomics so the overlay and the trace dump can
+// read a ring while its thread keeps writing, without locks. The sequence
+// works as a seqlock per slot, so a reader can tell a finished event from a
+// half-written or overwritten one.
+struct ProfileEvent {
+    std::atomic<std::uint64_t> sequence; // 2 * index + 1 while index is written, 2 * index + 2 once done
+    std::atomic<const char*> name;
+    std::atomic<std::uint64_t> start; // Nanoseconds since the profiler started
+    std::atomic<std::uint64_t> end;
+};
+
+// Plain copy of a ProfileEvent
+struct ProfileSample {
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t end;
+    int thread;
+};
+
+// Fixed-size ring written by a single thread. Old events are overwritten.
+class ProfileRing {
+public:
+    static const std::uint64_t CAPACITY = 1 << 16; // Power of two
+
+    explicit ProfileRing(int thread);
+
+    void push(const char* name, std::uint64_t start, std::uint64_t end);
+    // Copy events [from, write index) that are still whole in the ring; returns the write index
+    std::uint64_t copy(std::uint64_t from, std::vector<ProfileSample>& samples) const;
+
+private:
+    std::unique_ptr<ProfileEvent[]> events;
+    std::atomic<std::uint64_t> writeIndex;
+    int thread;
+};
+
+struct ZoneStat {
+    const char* name;
+    double lastMs;    // Total time inside the zone during the last frame
+    double averageMs; // Smoothed over recent frames
+};
+
+// Frame profiler. Scoped zones (PROFILE_ZONE) record into a ring owned by
+// their thread; endFrame() folds the new zones of every thread's ring into
+// per-frame stats, so the render thread's overlay also shows the simulation
+// and worker zones. While disabled a zone costs one relaxed atomic load, so it
+// stays compiled into release builds. Define PROFILER_DISABLED to remove
+// the zones entirely.
+class Profiler {
+public:
+    static const int FRAME_HISTORY = 240; // Frames kept for the graph and percentiles
+
+    static Profiler& instance();
+
+    static bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+    // Safe from any thread, the frame stats pick the change up in endFrame()
+    void setEnabled(bool enabled);
+    void toggle();
+
+    static std::uint64_t now();
+    void record(const char* name, std::uint64_t start, std::uint64_t end);
+
+    // Call once per frame on the thread drawing the overlay, after display
+    void endFrame();
+
+    const std::vector<ZoneStat>& getZoneStats() const;
+    // Frame times in ms, oldest first
+    std::vector<float> getFrameHistory() const;
+    // Frame time in ms at the given percentile (0-100) of the history
+    float getFramePercentile(float percentile) const;
+
+    // Write every zone of the last `seconds` as a Chrome trace (chrome://tracing, Perfetto)
+    bool dumpChromeTrace(const std::string& path, double seconds) const;
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ProfileRing& threadRing();
+
+    static std::atomic<bool> enabled;
+
+    // Only taken when a thread records its first zone, once per frame and by dumps
+    mutable std::mutex ringsMutex;
+    std::vector<std::unique_ptr<ProfileRing>> rings;
+
+    // Frame stats, owned by the endFrame thread
+    std::vector<std::uint64_t> readIndices; // Per ring, events already folded
+    bool wasEnabled; // As the last endFrame saw it
+    std::uint64_t frameStart;
+    std::vector<ZoneStat> zoneStats;
+    std::vector<ProfileSample> frameSamples; // Scratch
+    float frameTimes[FRAME_HISTORY];
+    int frameCursor;
+    int frameCount;
+};
+
+// Times the enclosing scope
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) :
+        name(name),
+        start(Profiler::isEnabled() ? Profiler::now() : 0)
+    {
+    }
+
+    ~ProfileZone() {
+        if (start != 0) {
+            Profiler::instance().record(name, start, Profiler::now());
+        }
+    }
+
+private:
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+    const char* name; // Must be a string literal, zones are grouped by pointer
+    std::uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_DISABLED
+#define PROFILE_ZONE(name)
+#else
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#endif
+
+#endif // PROFILER_H
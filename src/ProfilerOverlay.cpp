@@ -0,0 +1,97 @@
+#include "ProfilerOverlay.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+const float GRAPH_HEIGHT = 80.0f;
+const float GRAPH_MAX_MS = 33.3f; // Top of the graph, two frames at 60 Hz
+const float FRAME_BUDGET_MS = 1000.0f / 60.0f;
+const sf::Color BACKGROUND_COLOR(0, 0, 0, 160);
+const sf::Color BUDGET_COLOR(255, 255, 255, 120);
+
+} // namespace
+
+ProfilerOverlay::ProfilerOverlay() :
+    visibleEnemies(0),
+    culledEnemies(0),
+    liveParticles(0),
+    droppedParticles(0)
+{
+}
+
+void ProfilerOverlay::setEnemyCounts(int visible, int culled) {
+    visibleEnemies = visible;
+    culledEnemies = culled;
+}
+
+void ProfilerOverlay::setParticleCounts(int live, unsigned int dropped) {
+    liveParticles = live;
+    droppedParticles = dropped;
+}
+
+void ProfilerOverlay::init(const sf::Font& font, const sf::Vector2f& position) {
+    this->position = position;
+    text.setFont(font);
+    text.setCharacterSize(14);
+    text.setFillColor(sf::Color::White);
+    text.setPosition(position.x, position.y + GRAPH_HEIGHT + 6.0f);
+}
+
+void ProfilerOverlay::addQuad(const sf::FloatRect& rect, const sf::Color& color) {
+    sf::Vector2f topLeft(rect.left, rect.top);
+    sf::Vector2f topRight(rect.left + rect.width, rect.top);
+    sf::Vector2f bottomRight(rect.left + rect.width, rect.top + rect.height);
+    sf::Vector2f bottomLeft(rect.left, rect.top + rect.height);
+    vertices.push_back(sf::Vertex(topLeft, color));
+    vertices.push_back(sf::Vertex(topRight, color));
+    vertices.push_back(sf::Vertex(bottomRight, color));
+    vertices.push_back(sf::Vertex(topLeft, color));
+    vertices.push_back(sf::Vertex(bottomRight, color));
+    vertices.push_back(sf::Vertex(bottomLeft, color));
+}
+
+void ProfilerOverlay::render(RenderQueue& queue) {
+    if (!Profiler::isEnabled()) {
+        return;
+    }
+    vertices.clear();
+
+    // One bar per frame, one pixel wide, newest on the right
+    const float width = static_cast<float>(Profiler::FRAME_HISTORY);
+    addQuad(sf::FloatRect(position.x, position.y, width, GRAPH_HEIGHT), BACKGROUND_COLOR);
+    std::vector<float> history = Profiler::instance().getFrameHistory();
+    float x = position.x + width - history.size();
+    for (float ms : history) {
+        float height = std::min(ms / GRAPH_MAX_MS, 1.0f) * GRAPH_HEIGHT;
+        sf::Color color = ms <= FRAME_BUDGET_MS ? sf::Color::Green : (ms <= GRAPH_MAX_MS ? sf::Color::Yellow : sf::Color::Red);
+        addQuad(sf::FloatRect(x, position.y + GRAPH_HEIGHT - height, 1.0f, height), color);
+        x += 1.0f;
+    }
+    float budgetY = position.y + GRAPH_HEIGHT - FRAME_BUDGET_MS / GRAPH_MAX_MS * GRAPH_HEIGHT;
+    addQuad(sf::FloatRect(position.x, budgetY, width, 1.0f), BUDGET_COLOR);
+
+    queue.submitVertices(LAYER_DEBUG, nullptr, vertices.data(), vertices.size());
+}
+
+void ProfilerOverlay::renderText(sf::RenderTarget& target) {
+    if (!Profiler::isEnabled()) {
+        return;
+    }
+    const Profiler& profiler = Profiler::instance();
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2);
+    ss << "frame p50 " << profiler.getFramePercentile(50.0f)
+       << "  p95 " << profiler.getFramePercentile(95.0f)
+       << "  p99 " << profiler.getFramePercentile(99.0f) << " ms\n";
+    ss << "enemies " << visibleEnemies << " drawn  " << culledEnemies << " culled\n";
+    ss << "particles " << liveParticles << " live  " << droppedParticles << " dropped\n";
+    for (const ZoneStat& stat : profiler.getZoneStats()) {
+        ss << std::setw(7) << stat.averageMs << " ms  " << stat.name << "\n";
+    }
+    text.setString(ss.str());
+    target.draw(text);
+}
@@ -0,0 +1,36 @@
+#ifndef PROFILEROVERLAY_H
+#define PROFILEROVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "RenderQueue.h"
+
+// On-screen view of the Profiler: frame time graph, percentiles and the
+// time spent in every zone. Only draws while the profiler is enabled.
+class ProfilerOverlay {
+public:
+    ProfilerOverlay();
+
+    void init(const sf::Font& font, const sf::Vector2f& position);
+
+    // Graph, submitted with the rest of the frame
+    void render(RenderQueue& queue);
+    // Text, drawn after the queue was flushed
+    void renderText(sf::RenderTarget& target);
+    // Culling stats of the last frame, listed under the percentiles
+    void setEnemyCounts(int visible, int culled);
+    void setParticleCounts(int live, unsigned int dropped);
+
+private:
+    void addQuad(const sf::FloatRect& rect, const sf::Color& color);
+
+    sf::Vector2f position; // Top-left of the panel
+    sf::Text text;
+    int visibleEnemies;
+    int culledEnemies;
+    int liveParticles;
+    unsigned int droppedParticles;
+    std::vector<sf::Vertex> vertices; // Must outlive the queue flush
+};
+
+#endif // PROFILEROVERLAY_H
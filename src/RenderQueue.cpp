@@ -0,0 +1,161 @@
+#include "RenderQueue.h"
+#include <algorithm>
+#include <functional>
+
+RenderQueue::RenderQueue() :
+    commandCount(0),
+    batchCount(0),
+    vertexCount(0)
+{
+}
+
+void RenderQueue::submit(int layer, const sf::Texture* texture, const sf::FloatRect& quad,
+                         const sf::IntRect& textureRect, const sf::Color& color, bool flipX) {
+    if (quad.width <= 0 || quad.height <= 0) {
+        return; // Empty frame, nothing to draw
+    }
+
+    RenderCommand command;
+    command.layer = layer;
+    command.texture = texture;
+    command.quad = quad;
+    command.textureRect = textureRect;
+    command.color = color;
+    command.flipX = flipX;
+    command.sequence = static_cast<unsigned int>(commands.size());
+    command.vertices = nullptr;
+    command.vertexCount = 0;
+    command.primitive = sf::Triangles;
+    commands.push_back(command);
+}
+
+void RenderQueue::submit(int layer, const sf::Sprite& sprite, const sf::Vector2f& offset) {
+    sf::FloatRect bounds = sprite.getGlobalBounds();
+    bounds.left += offset.x;
+    bounds.top += offset.y;
+    submit(layer, sprite.getTexture(), bounds, sprite.getTextureRect(),
+           sprite.getColor(), sprite.getScale().x < 0);
+}
+
+void RenderQueue::submit(int layer, const AtlasFrame& frame, const sf::Vector2f& position, const sf::Vector2f& pivot,
+                         float scale, bool flipX, const sf::Color& color) {
+    sf::FloatRect quad;
+    quad.width = frame.rect.width * scale;
+    quad.height = frame.rect.height * scale;
+    quad.top = position.y + (frame.offset.y - pivot.y) * scale;
+    // Mirroring happens around the pivot, so the trimmed rect swaps sides
+    float left = (frame.offset.x - pivot.x) * scale;
+    quad.left = flipX ? position.x - left - quad.width : position.x + left;
+    submit(layer, frame.texture, quad, frame.rect, color, flipX);
+}
+
+void RenderQueue::submit(int layer, const sf::FloatRect& quad, const sf::Color& color) {
+    submit(layer, nullptr, quad, sf::IntRect(0, 0, 0, 0), color, false);
+}
+
+void RenderQueue::submitVertices(int layer, const sf::Texture* texture, const sf::Vertex* vertices, std::size_t count,
+                                 sf::PrimitiveType primitive) {
+    if (count == 0) {
+        return;
+    }
+
+    RenderCommand command;
+    command.layer = layer;
+    command.texture = texture;
+    command.flipX = false;
+    command.sequence = static_cast<unsigned int>(commands.size());
+    command.vertices = vertices;
+    command.vertexCount = count;
+    command.primitive = primitive;
+    commands.push_back(command);
+}
+
+void RenderQueue::appendQuad(const RenderCommand& command) {
+    const sf::FloatRect& q = command.quad;
+    const sf::IntRect& t = command.textureRect;
+
+    float left = static_cast<float>(t.left);
+    float right = static_cast<float>(t.left + t.width);
+    if (command.flipX) {
+        std::swap(left, right);
+    }
+    float top = static_cast<float>(t.top);
+    float bottom = static_cast<float>(t.top + t.height);
+
+    sf::Vertex topLeft(sf::Vector2f(q.left, q.top), command.color, sf::Vector2f(left, top));
+    sf::Vertex topRight(sf::Vector2f(q.left + q.width, q.top), command.color, sf::Vector2f(right, top));
+    sf::Vertex bottomRight(sf::Vector2f(q.left + q.width, q.top + q.height), command.color, sf::Vector2f(right, bottom));
+    sf::Vertex bottomLeft(sf::Vector2f(q.left, q.top + q.height), command.color, sf::Vector2f(left, bottom));
+
+    // Two triangles per quad
+    vertices.push_back(topLeft);
+    vertices.push_back(topRight);
+    vertices.push_back(bottomRight);
+    vertices.push_back(topLeft);
+    vertices.push_back(bottomRight);
+    vertices.push_back(bottomLeft);
+}
+
+void RenderQueue::flush(sf::RenderTarget& target, const sf::RenderStates& states) {
+    std::sort(commands.begin(), commands.end(), [](const RenderCommand& a, const RenderCommand& b) {
+        if (a.layer != b.layer) {
+            return a.layer < b.layer;
+        }
+        if (a.texture != b.texture) {
+            return std::less<const sf::Texture*>()(a.texture, b.texture);
+        }
+        return a.sequence < b.sequence;
+    });
+
+    vertices.clear();
+    vertices.reserve(commands.size() * 6);
+    commandCount = static_cast<unsigned int>(commands.size());
+    batchCount = 0;
+    vertexCount = 0;
+
+    std::size_t runStart = 0;
+    while (runStart < commands.size()) {
+        sf::RenderStates batchStates(states);
+        batchStates.texture = commands[runStart].texture;
+
+        // Prebuilt vertex batches are drawn as they are
+        if (commands[runStart].vertices) {
+            target.draw(commands[runStart].vertices, commands[runStart].vertexCount, commands[runStart].primitive,
+                        batchStates);
+            vertexCount += static_cast<unsigned int>(commands[runStart].vertexCount);
+            batchCount++;
+            runStart++;
+            continue;
+        }
+
+        // Extend the run while layer and texture stay the same
+        std::size_t runEnd = runStart;
+        std::size_t firstVertex = vertices.size();
+        while (runEnd < commands.size() && !commands[runEnd].vertices &&
+               commands[runEnd].layer == commands[runStart].layer &&
+               commands[runEnd].texture == commands[runStart].texture) {
+            appendQuad(commands[runEnd]);
+            runEnd++;
+        }
+
+        target.draw(&vertices[firstVertex], vertices.size() - firstVertex, sf::Triangles, batchStates);
+        batchCount++;
+
+        runStart = runEnd;
+    }
+
+    vertexCount += static_cast<unsigned int>(vertices.size());
+    commands.clear();
+}
+
+unsigned int RenderQueue::getCommandCount() const {
+    return commandCount;
+}
+
+unsigned int RenderQueue::getBatchCount() const {
+    return batchCount;
+}
+
+unsigned int RenderQueue::getVertexCount() const {
+    return vertexCount;
+}
@@ -0,0 +1,74 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "SpriteAtlas.h"
+
+// Draw order, lowest first
+enum RenderLayer {
+    LAYER_BACKGROUND,
+    LAYER_PLAYER,
+    LAYER_BULLETS,
+    LAYER_ENEMIES,
+    LAYER_EFFECTS,
+    LAYER_DEBUG,
+    LAYER_HUD,
+    LAYER_COUNT
+};
+
+// One axis-aligned textured (or plain colored) quad
+struct RenderCommand {
+    int layer;
+    const sf::Texture* texture; // nullptr for untextured quads
+    sf::FloatRect quad;         // World space rectangle
+    sf::IntRect textureRect;    // Source rectangle in texture pixels
+    sf::Color color;
+    bool flipX;
+    unsigned int sequence;      // Submission order, keeps the sort stable
+    const sf::Vertex* vertices; // Prebuilt primitives owned by the caller, or nullptr
+    std::size_t vertexCount;
+    sf::PrimitiveType primitive; // Of the prebuilt vertices
+};
+
+// Collects quads during the frame, sorts them by layer and texture and
+// draws every run sharing a texture with a single draw call.
+class RenderQueue {
+public:
+    RenderQueue();
+
+    void submit(int layer, const sf::Texture* texture, const sf::FloatRect& quad,
+                const sf::IntRect& textureRect, const sf::Color& color, bool flipX);
+    // Sprites must not be rotated, mirroring is taken from a negative x scale.
+    // The offset moves the quad, e.g. to draw an interpolated position.
+    void submit(int layer, const sf::Sprite& sprite, const sf::Vector2f& offset = sf::Vector2f(0.0f, 0.0f));
+    // Atlas frame placed so the pivot (in untrimmed cell pixels) lands on position
+    void submit(int layer, const AtlasFrame& frame, const sf::Vector2f& position, const sf::Vector2f& pivot,
+                float scale, bool flipX, const sf::Color& color = sf::Color::White);
+    // Untextured quad
+    void submit(int layer, const sf::FloatRect& quad, const sf::Color& color);
+    // Primitives built by the caller, drawn as one batch. They must stay valid until flush().
+    // Quads save a third of the vertices for many small sprites.
+    void submitVertices(int layer, const sf::Texture* texture, const sf::Vertex* vertices, std::size_t count,
+                        sf::PrimitiveType primitive = sf::Triangles);
+
+    // Draw everything submitted since the last flush and reset the queue
+    void flush(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default);
+
+    // Counters for the last flushed frame
+    unsigned int getCommandCount() const;
+    unsigned int getBatchCount() const;
+    unsigned int getVertexCount() const;
+
+private:
+    void appendQuad(const RenderCommand& command);
+
+    std::vector<RenderCommand> commands;
+    std::vector<sf::Vertex> vertices; // Reused between frames
+
+    unsigned int commandCount;
+    unsigned int batchCount;
+    unsigned int vertexCount;
+};
+
+#endif // RENDERQUEUE_H
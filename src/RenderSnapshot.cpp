@@ -0,0 +1,105 @@
+#include "RenderSnapshot.h"
+#include "GameWorld.h"
+
+namespace {
+
+const float GRENADE_SPIN_RATE = 12.0f; // Frames per second
+const int GRENADE_FRAMES = 3;
+
+} // namespace
+
+RenderSnapshot::RenderSnapshot() :
+    previousCameraCenter(Camera::VIEW_WIDTH / 2.0f, Camera::VIEW_HEIGHT / 2.0f),
+    cameraCenter(previousCameraCenter),
+    worldWidth(Camera::VIEW_WIDTH),
+    ammo(0),
+    maxAmmo(0),
+    grenadesLeft(0),
+    health(0.0f),
+    wave(0),
+    waveTransitioning(false),
+    gameOver(false),
+    victory(false),
+    showHitboxes(false),
+    tick(0)
+{
+    player.clip = CLIP_PLAYER_IDLE;
+    player.frame = 0;
+    player.facingRight = true;
+    player.flashing = false;
+}
+
+void RenderSnapshot::capture(const GameWorld& world, bool withHitboxes) {
+    const Player& worldPlayer = world.getPlayer();
+    player.previousPosition = worldPlayer.getPreviousPosition();
+    player.position = worldPlayer.getPosition();
+    player.clip = worldPlayer.getAnimation();
+    player.frame = worldPlayer.getCurrentFrame();
+    player.facingRight = worldPlayer.isFacingRight();
+    player.flashing = worldPlayer.isFlashing();
+
+    const EnemyManager& enemyManager = world.getEnemies();
+    enemies.clear();
+    for (int i = 0; i < enemyManager.getActiveCount(); i++) {
+        const Enemy& enemy = enemyManager.getActiveEnemy(i);
+        EnemySnapshot snapshot;
+        snapshot.previousPosition = enemy.getPreviousPosition();
+        snapshot.position = enemy.getPosition();
+        snapshot.clip = enemy.getAnimation();
+        snapshot.frame = enemy.getCurrentFrame();
+        snapshot.facingRight = enemy.isFacingRight();
+        enemies.push_back(snapshot);
+    }
+
+    const BulletManager& bulletManager = world.getBullets();
+    bullets.clear();
+    for (int i = 0; i < bulletManager.getActiveCount(); i++) {
+        if (!bulletManager.isActive(i)) {
+            continue;
+        }
+        BulletSnapshot snapshot;
+        snapshot.previousBounds = bulletManager.getBounds(i, 0.0f);
+        snapshot.bounds = bulletManager.getBounds(i);
+        bullets.push_back(snapshot);
+    }
+
+    const GrenadeManager& grenadeManager = world.getGrenades();
+    grenades.clear();
+    for (int i = 0; i < grenadeManager.getActiveCount(); i++) {
+        GrenadeSnapshot snapshot;
+        snapshot.previousPosition = grenadeManager.getPreviousPosition(i);
+        snapshot.position = grenadeManager.getPosition(i);
+        snapshot.frame = static_cast<int>(grenadeManager.getFuse(i) * GRENADE_SPIN_RATE) % GRENADE_FRAMES;
+        grenades.push_back(snapshot);
+    }
+
+    hitboxes.clear();
+    bulletBoxes.clear();
+    showHitboxes = withHitboxes;
+    if (withHitboxes) {
+        hitboxes.push_back(worldPlayer.getHitbox());
+        for (int i = 0; i < enemyManager.getActiveCount(); i++) {
+            hitboxes.push_back(enemyManager.getActiveEnemy(i).getHitbox());
+        }
+        for (int i = 0; i < bulletManager.getActiveCount(); i++) {
+            bulletBoxes.push_back(bulletManager.getBounds(i));
+        }
+    }
+
+    const Camera& camera = world.getCamera();
+    previousCameraCenter = camera.getPreviousCenter();
+    cameraCenter = camera.getCenter();
+    worldWidth = camera.getWorldWidth();
+
+    ammo = bulletManager.getRemainingBullets();
+    maxAmmo = bulletManager.getMaxBullets();
+    grenadesLeft = grenadeManager.getRemainingGrenades();
+    health = worldPlayer.getHealth();
+    wave = enemyManager.getCurrentWave();
+    waveTransitioning = enemyManager.getIsWaveTransitioning();
+    gameOver = world.isGameOver();
+    victory = world.isCampaignComplete();
+
+    tick = world.getTickCount();
+    time = std::chrono::steady_clock::now();
+}
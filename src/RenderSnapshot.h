@@ -0,0 +1,83 @@
+#ifndef RENDERSNAPSHOT_H
+#define RENDERSNAPSHOT_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "Enemy.h"
+#include "Hitbox.h"
+#include "Player.h"
+
+class GameWorld;
+
+struct PlayerSnapshot {
+    sf::Vector2f previousPosition;
+    sf::Vector2f position;
+    AnimationClipId clip;
+    int frame;
+    bool facingRight;
+    bool flashing;
+};
+
+struct EnemySnapshot {
+    sf::Vector2f previousPosition;
+    sf::Vector2f position;
+    AnimationClipId clip;
+    int frame;
+    bool facingRight;
+};
+
+struct GrenadeSnapshot {
+    sf::Vector2f previousPosition;
+    sf::Vector2f position;
+    int frame; // Spinning through the first frames of the explosion strip
+};
+
+struct BulletSnapshot {
+    sf::FloatRect previousBounds;
+    sf::FloatRect bounds;
+};
+
+// Everything the render thread needs from one simulation tick, copied out
+// so drawing never reads the GameWorld while it is being advanced. Previous
+// and current positions are both kept for interpolation. The vectors keep
+// their capacity, so capturing into a reused snapshot does not allocate.
+struct RenderSnapshot {
+    RenderSnapshot();
+
+    void capture(const GameWorld& world, bool withHitboxes);
+
+    PlayerSnapshot player;
+    std::vector<EnemySnapshot> enemies;
+    std::vector<BulletSnapshot> bullets;
+    std::vector<GrenadeSnapshot> grenades;
+    std::vector<Hitbox> hitboxes;          // Only filled for the debug overlay
+    std::vector<sf::FloatRect> bulletBoxes; // Likewise
+    // Level backgrounds, back to front. Holding them keeps a texture alive
+    // while the render thread may still draw it after a level change.
+    std::vector<std::shared_ptr<sf::Texture>> backgrounds;
+
+    // Camera, interpolated like everything else
+    sf::Vector2f previousCameraCenter;
+    sf::Vector2f cameraCenter;
+    float worldWidth;
+
+    // HUD values
+    int ammo;
+    int maxAmmo;
+    int grenadesLeft;
+    float health;
+    int wave;
+    bool waveTransitioning;
+    bool gameOver;
+    bool victory; // Game over because the last level was cleared
+    bool showHitboxes;
+
+    unsigned long tick;
+    std::chrono::steady_clock::time_point time; // When the tick was captured
+};
+
+#endif // RENDERSNAPSHOT_H
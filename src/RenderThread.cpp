@@ -0,0 +1,249 @@
+#include "RenderThread.h"
+#include "Camera.h"
+#include "HudText.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace {
+
+const unsigned int HUD_SIZES[] = { 24, 30, 48, 50 }; // Every character size the HUD uses
+const float MAX_PARTICLE_STEP = 0.1f; // Seconds, a stalled frame must not fling particles away
+
+} // namespace
+
+RenderThread::RenderThread() :
+    window(nullptr),
+    running(false),
+    tickDuration(1.0f / 60.0f),
+    worldView(sf::FloatRect(0.0f, 0.0f, Camera::VIEW_WIDTH, Camera::VIEW_HEIGHT)),
+    ammoText(0),
+    healthText(0),
+    grenadeText(0),
+    waveText(0),
+    waveTransitionText(0),
+    gameOverText(0),
+    victoryText(0),
+    shownAmmo(-1),
+    shownMaxAmmo(-1),
+    shownHealth(-1),
+    shownGrenades(-1),
+    shownWave(-1)
+{
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start(sf::RenderWindow& window, const sf::Font& font, float tickDuration, const std::function<void()>& onFirstFrame) {
+    this->window = &window;
+    this->tickDuration = tickDuration;
+    this->onFirstFrame = onFirstFrame;
+
+    // The atlas goes through the ResourceCache, which belongs to the main thread
+    gameRenderer.init();
+
+    // HUD text, baked into a bitmap font while this thread still has the context
+    hud.init(font, HUD_SIZES, sizeof(HUD_SIZES) / sizeof(HUD_SIZES[0]));
+    ammoText = hud.addText(24, sf::Vector2f(10, 10), sf::Color::White);
+    healthText = hud.addText(24, sf::Vector2f(10, 50), sf::Color::White);
+    grenadeText = hud.addText(24, sf::Vector2f(10, 90), sf::Color::White);
+    waveText = hud.addText(30, sf::Vector2f(window.getSize().x - 200.0f, 10), sf::Color::White); // Top-right corner
+    waveTransitionText = hud.addText(50, sf::Vector2f(640, 360), sf::Color::White); // Centered position on screen
+    gameOverText = hud.addText(48, sf::Vector2f(window.getSize().x / 2 - 150.0f, window.getSize().y / 2 - 50.0f), sf::Color::Red);
+    hud.setText(gameOverText, "Game Over!");
+    victoryText = hud.addText(48, sf::Vector2f(window.getSize().x / 2 - 170.0f, window.getSize().y / 2 - 50.0f), sf::Color::Green);
+    hud.setText(victoryText, "You escaped!");
+    hud.setVisible(waveTransitionText, false);
+    hud.setVisible(gameOverText, false);
+    hud.setVisible(victoryText, false);
+
+    // Frame profiler panel, its stats are those of the render thread
+    profilerOverlay.init(font, sf::Vector2f(10, 140));
+
+    // A context can only be active on one thread at a time
+    window.setActive(false);
+    running = true;
+    thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+    if (!thread.joinable()) {
+        return;
+    }
+    running = false;
+    thread.join();
+    window->setActive(true);
+}
+
+RenderSnapshot& RenderThread::getSnapshot() {
+    return snapshots.getWriteBuffer();
+}
+
+void RenderThread::publishSnapshot() {
+    snapshots.publish();
+}
+
+void RenderThread::addEffects(const GameEvents& events) {
+    if (events.effects.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(effectsMutex);
+    effectQueue.insert(effectQueue.end(), events.effects.begin(), events.effects.end());
+}
+
+void RenderThread::run() {
+    window->setActive(true);
+
+    bool hasSnapshot = false;
+    bool presented = false;
+    std::chrono::steady_clock::time_point lastFrame = std::chrono::steady_clock::now();
+    while (running) {
+        if (snapshots.fetch()) {
+            hasSnapshot = true;
+        }
+        if (!hasSnapshot) {
+            // The simulation has not finished its first tick yet
+            sf::sleep(sf::milliseconds(1));
+            continue;
+        }
+
+        // Blend from the previous tick to the newest one over one tick duration
+        const RenderSnapshot& snapshot = snapshots.getReadBuffer();
+        std::chrono::duration<float> sinceTick = std::chrono::steady_clock::now() - snapshot.time;
+        float alpha = std::min(sinceTick.count() / tickDuration, 1.0f);
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        std::chrono::duration<float> frameTime = now - lastFrame;
+        lastFrame = now;
+        updateParticles(std::min(frameTime.count(), MAX_PARTICLE_STEP));
+        drawFrame(snapshot, alpha);
+
+        {
+            PROFILE_ZONE("Display");
+            window->display();
+        }
+        Profiler::instance().endFrame();
+
+        if (!presented) {
+            presented = true;
+            if (onFirstFrame) {
+                onFirstFrame();
+            }
+        }
+    }
+
+    window->setActive(false);
+}
+
+void RenderThread::drawFrame(const RenderSnapshot& snapshot, float alpha) {
+    window->clear();
+    updateHud(snapshot);
+
+    worldView.setCenter(snapshot.previousCameraCenter + (snapshot.cameraCenter - snapshot.previousCameraCenter) * alpha);
+    window->setView(worldView);
+    const sf::Vector2f& center = worldView.getCenter();
+    const sf::Vector2f& size = worldView.getSize();
+    const sf::FloatRect view(center.x - size.x / 2.0f, center.y - size.y / 2.0f, size.x, size.y);
+
+    if (snapshot.gameOver) {
+        drawBackgrounds(snapshot, view);
+        window->setView(window->getDefaultView());
+        hud.render(renderQueue);
+        renderQueue.flush(*window);
+        return;
+    }
+
+    {
+        PROFILE_ZONE("Render::submit");
+        drawBackgrounds(snapshot, view);
+        // Draw the player, bullets and enemies
+        gameRenderer.render(renderQueue, snapshot, alpha, view);
+        gameRenderer.renderParticles(renderQueue, particles);
+        profilerOverlay.setEnemyCounts(gameRenderer.getVisibleEnemyCount(), gameRenderer.getCulledEnemyCount());
+        profilerOverlay.setParticleCounts(particles.getLiveCount(), particles.getDroppedCount());
+        // Draw hitboxes for debugging
+        if (hitboxOverlay.isEnabled() != snapshot.showHitboxes) {
+            hitboxOverlay.setEnabled(snapshot.showHitboxes);
+        }
+        if (hitboxOverlay.isEnabled()) {
+            for (const Hitbox& hitbox : snapshot.hitboxes) {
+                hitboxOverlay.add(hitbox);
+            }
+            for (const sf::FloatRect& bounds : snapshot.bulletBoxes) {
+                hitboxOverlay.add(bounds);
+            }
+            hitboxOverlay.render(renderQueue);
+        }
+    }
+    {
+        PROFILE_ZONE("Render::flush");
+        renderQueue.flush(*window);
+    }
+
+    // Screen space from here on
+    window->setView(window->getDefaultView());
+    {
+        PROFILE_ZONE("Render::overlay");
+        profilerOverlay.render(renderQueue);
+        // Draw UI
+        hud.render(renderQueue);
+        renderQueue.flush(*window);
+    }
+    profilerOverlay.renderText(*window);
+}
+
+void RenderThread::drawBackgrounds(const RenderSnapshot& snapshot, const sf::FloatRect& view) {
+    PROFILE_ZONE("Render::background");
+    // Drawn straight away, before the queue is flushed: the queue groups a
+    // layer by texture, which would shuffle the background layers
+    background.setLayers(snapshot.backgrounds, snapshot.worldWidth, Camera::VIEW_HEIGHT);
+    background.draw(*window, view);
+}
+
+void RenderThread::updateParticles(float deltaTime) {
+    PROFILE_ZONE("Particles::update");
+    {
+        std::lock_guard<std::mutex> lock(effectsMutex);
+        pendingEffects.swap(effectQueue);
+    }
+    particles.emit(pendingEffects);
+    pendingEffects.clear();
+    particles.update(deltaTime);
+}
+
+void RenderThread::updateHud(const RenderSnapshot& snapshot) {
+    PROFILE_ZONE("Render::hud");
+    char text[HudLayer::MAX_TEXT_LENGTH + 1];
+    if (snapshot.ammo != shownAmmo || snapshot.maxAmmo != shownMaxAmmo) {
+        shownAmmo = snapshot.ammo;
+        shownMaxAmmo = snapshot.maxAmmo;
+        formatAmmo(text, sizeof(text), shownAmmo, shownMaxAmmo);
+        hud.setText(ammoText, text);
+    }
+    if (static_cast<int>(snapshot.health) != shownHealth) {
+        shownHealth = static_cast<int>(snapshot.health);
+        formatHealth(text, sizeof(text), snapshot.health);
+        hud.setText(healthText, text);
+    }
+    if (snapshot.grenadesLeft != shownGrenades) {
+        shownGrenades = snapshot.grenadesLeft;
+        formatGrenades(text, sizeof(text), shownGrenades);
+        hud.setText(grenadeText, text);
+    }
+    if (snapshot.wave != shownWave) {
+        shownWave = snapshot.wave;
+        formatWave(text, sizeof(text), shownWave);
+        hud.setText(waveText, text);
+        formatWaveBanner(text, sizeof(text), shownWave);
+        hud.setText(waveTransitionText, text);
+    }
+
+    // Only the banner is left on the game over screen
+    hud.setVisible(ammoText, !snapshot.gameOver);
+    hud.setVisible(healthText, !snapshot.gameOver);
+    hud.setVisible(grenadeText, !snapshot.gameOver);
+    hud.setVisible(waveText, !snapshot.gameOver);
+    hud.setVisible(waveTransitionText, snapshot.waveTransitioning && !snapshot.gameOver);
+    hud.setVisible(gameOverText, snapshot.gameOver && !snapshot.victory);
+    hud.setVisible(victoryText, snapshot.gameOver && snapshot.victory);
+}
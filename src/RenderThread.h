@@ -0,0 +1,92 @@
+#ifndef RENDERTHREAD_H
+#define RENDERTHREAD_H
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ChunkedBackground.h"
+#include "GameEvents.h"
+#include "GameRenderer.h"
+#include "ParticleSystem.h"
+#include "HitboxOverlay.h"
+#include "HudLayer.h"
+#include "ProfilerOverlay.h"
+#include "RenderQueue.h"
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+
+// Owns the window's GL context on a thread of its own. The simulation
+// publishes one RenderSnapshot per tick; the render thread always draws the
+// newest one, interpolating from the previous tick by the time elapsed since
+// it was captured. Simulation and presentation overlap instead of waiting on
+// each other. Events and input stay on the thread that created the window.
+class RenderThread {
+public:
+    RenderThread();
+    ~RenderThread();
+
+    // Call once every asset is in the ResourceCache. The calling thread gives
+    // up the GL context until stop(). onFirstFrame runs on the render thread
+    // after the first gameplay frame was presented.
+    void start(sf::RenderWindow& window, const sf::Font& font, float tickDuration, const std::function<void()>& onFirstFrame);
+    // Join the render thread and hand the GL context back to the caller
+    void stop();
+
+    // Simulation side: fill the snapshot, then publish it
+    RenderSnapshot& getSnapshot();
+    void publishSnapshot();
+    // Queue the particle effects of a tick. Unlike snapshots none are
+    // skipped when several ticks run between two frames.
+    void addEffects(const GameEvents& events);
+
+private:
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    void run();
+    void drawFrame(const RenderSnapshot& snapshot, float alpha);
+    // Background in world space, the view has to be set
+    void drawBackgrounds(const RenderSnapshot& snapshot, const sf::FloatRect& view);
+    void updateHud(const RenderSnapshot& snapshot);
+    void updateParticles(float deltaTime);
+
+    sf::RenderWindow* window;
+    std::thread thread;
+    std::atomic<bool> running;
+    TripleBuffer<RenderSnapshot> snapshots;
+    float tickDuration;
+    std::function<void()> onFirstFrame;
+
+    // Effect queue, shared with the simulation thread
+    std::mutex effectsMutex;
+    std::vector<EffectEvent> effectQueue;
+
+    // Everything below is only touched by the render thread
+    GameRenderer gameRenderer;
+    RenderQueue renderQueue; // Sprites are batched per layer and texture
+    sf::View worldView; // Follows the camera, the HUD uses the window's default view
+    ChunkedBackground background;
+    std::vector<EffectEvent> pendingEffects; // Swapped with the queue
+    ParticleSystem particles;
+    HitboxOverlay hitboxOverlay;
+    ProfilerOverlay profilerOverlay;
+    HudLayer hud;
+    int ammoText; // HudLayer ids
+    int healthText;
+    int grenadeText;
+    int waveText;
+    int waveTransitionText; // Shown between waves
+    int gameOverText;
+    int victoryText;
+    // Values the HUD texts currently show, -1 before the first snapshot
+    int shownAmmo;
+    int shownMaxAmmo;
+    int shownHealth;
+    int shownGrenades;
+    int shownWave;
+};
+
+#endif // RENDERTHREAD_H
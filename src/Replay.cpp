@@ -0,0 +1,166 @@
+#include "Replay.h"
+#include "GameWorld.h"
+#include "StateStream.h"
+#include "Log.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+
+const char MAGIC[4] = { 'Z', 'P', 'R', 'P' };
+const std::uint32_t VERSION = 7; // Keyframes hold raw state, bump when it or the simulation changes
+
+template <typename T>
+void writeValue(std::ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool readValue(std::ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+} // namespace
+
+Replay::Replay() :
+    seed(0),
+    tickRate(60.0f)
+{
+}
+
+void Replay::begin(std::uint64_t seed, float tickRate) {
+    this->seed = seed;
+    this->tickRate = tickRate;
+    inputs.clear();
+    keyframes.clear();
+}
+
+void Replay::record(const GameWorld& world, const InputState& input) {
+    std::uint32_t tick = static_cast<std::uint32_t>(inputs.size());
+    if (tick % KEYFRAME_INTERVAL == 0) {
+        StateWriter writer;
+        world.saveState(writer);
+        ReplayKeyframe keyframe;
+        keyframe.tick = tick;
+        keyframe.state = writer.getData();
+        keyframes.push_back(keyframe);
+    }
+    inputs.push_back(input.toBits());
+}
+
+bool Replay::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to write replay", LogField("path", path));
+        return false;
+    }
+
+    file.write(MAGIC, sizeof(MAGIC));
+    writeValue(file, VERSION);
+    writeValue(file, seed);
+    writeValue(file, tickRate);
+    writeValue(file, static_cast<std::uint32_t>(inputs.size()));
+    file.write(reinterpret_cast<const char*>(inputs.data()), inputs.size());
+
+    writeValue(file, static_cast<std::uint32_t>(keyframes.size()));
+    for (const ReplayKeyframe& keyframe : keyframes) {
+        writeValue(file, keyframe.tick);
+        writeValue(file, static_cast<std::uint32_t>(keyframe.state.size()));
+        file.write(keyframe.state.data(), keyframe.state.size());
+    }
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        LOG_ERROR("Failed to open replay", LogField("path", path));
+        return false;
+    }
+
+    char magic[4];
+    std::uint32_t version = 0;
+    std::uint32_t tickCount = 0;
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + 4, MAGIC) ||
+        !readValue(file, version) || version != VERSION) {
+        LOG_ERROR("Not a replay file, or from another version", LogField("path", path));
+        return false;
+    }
+
+    std::vector<std::uint8_t> loadedInputs;
+    std::vector<ReplayKeyframe> loadedKeyframes;
+    std::uint32_t keyframeCount = 0;
+    bool good = readValue(file, seed) && readValue(file, tickRate) && readValue(file, tickCount);
+    if (good) {
+        loadedInputs.resize(tickCount);
+        good = static_cast<bool>(file.read(reinterpret_cast<char*>(loadedInputs.data()), tickCount)) &&
+               readValue(file, keyframeCount);
+    }
+    for (std::uint32_t i = 0; good && i < keyframeCount; i++) {
+        ReplayKeyframe keyframe;
+        std::uint32_t size = 0;
+        good = readValue(file, keyframe.tick) && readValue(file, size);
+        if (good) {
+            keyframe.state.resize(size);
+            good = static_cast<bool>(file.read(keyframe.state.data(), size));
+            loadedKeyframes.push_back(keyframe);
+        }
+    }
+    if (!good) {
+        LOG_ERROR("Truncated replay", LogField("path", path));
+        return false;
+    }
+
+    inputs.swap(loadedInputs);
+    keyframes.swap(loadedKeyframes);
+    return true;
+}
+
+std::uint64_t Replay::getSeed() const {
+    return seed;
+}
+
+float Replay::getTickRate() const {
+    return tickRate;
+}
+
+std::uint32_t Replay::getTickCount() const {
+    return static_cast<std::uint32_t>(inputs.size());
+}
+
+InputState Replay::getInput(std::uint32_t tick) const {
+    if (tick >= inputs.size()) {
+        return InputState();
+    }
+    return InputState::fromBits(inputs[tick]);
+}
+
+bool Replay::seek(GameWorld& world, std::uint32_t tick) const {
+    if (tick > inputs.size()) {
+        tick = static_cast<std::uint32_t>(inputs.size());
+    }
+
+    // Latest keyframe at or before the tick
+    const ReplayKeyframe* start = nullptr;
+    for (const ReplayKeyframe& keyframe : keyframes) {
+        if (keyframe.tick > tick) {
+            break;
+        }
+        start = &keyframe;
+    }
+
+    world.init(seed);
+    if (start) {
+        StateReader reader(start->state.data(), start->state.size());
+        if (!world.loadState(reader)) {
+            LOG_ERROR("Corrupt replay keyframe", LogField("tick", start->tick));
+            return false;
+        }
+    }
+
+    const float tickDuration = 1.0f / tickRate;
+    while (world.getTickCount() < tick) {
+        world.tick(getInput(static_cast<std::uint32_t>(world.getTickCount())), tickDuration);
+    }
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameInput.h"
+
+class GameWorld;
+
+// Full simulation state captured right before a tick
+struct ReplayKeyframe {
+    std::uint32_t tick;
+    std::vector<char> state;
+};
+
+// Recorded run: the seed, one byte of input per tick and a full state
+// keyframe every KEYFRAME_INTERVAL ticks. Because the simulation is
+// deterministic, playing the inputs back from the seed reproduces the run
+// exactly, and the keyframes let playback jump to any tick without
+// simulating everything before it.
+//
+// File layout (native byte order):
+//   "ZPRP", version, seed, tick rate, tick count, input bytes,
+//   keyframe count, then per keyframe: tick, size, state bytes
+class Replay {
+public:
+    static const std::uint32_t KEYFRAME_INTERVAL = 600; // 10 seconds at 60 Hz
+
+    Replay();
+
+    // Recording. Call record() once per tick, before GameWorld::tick.
+    void begin(std::uint64_t seed, float tickRate);
+    void record(const GameWorld& world, const InputState& input);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+
+    std::uint64_t getSeed() const;
+    float getTickRate() const;
+    std::uint32_t getTickCount() const;
+    InputState getInput(std::uint32_t tick) const;
+
+    // Start a world from the seed, or from the last keyframe at or before
+    // the tick, and simulate forward until the next tick to run is `tick`
+    bool seek(GameWorld& world, std::uint32_t tick) const;
+
+private:
+    std::uint64_t seed;
+    float tickRate;
+    std::vector<std::uint8_t> inputs; // InputState::toBits per tick
+    std::vector<ReplayKeyframe> keyframes; // Sorted by tick
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,154 @@
+#include "ResourceCache.h"
+#include "Log.h"
+#include <fstream>
+
+namespace {
+
+// Approximate memory held by each resource type
+std::size_t residentSize(const sf::Texture& texture, const std::string&) {
+    sf::Vector2u size = texture.getSize();
+    return static_cast<std::size_t>(size.x) * size.y * 4; // RGBA8
+}
+
+std::size_t residentSize(const sf::SoundBuffer& buffer, const std::string&) {
+    return static_cast<std::size_t>(buffer.getSampleCount()) * sizeof(sf::Int16);
+}
+
+std::size_t residentSize(const sf::Font&, const std::string& path) {
+    // sf::Font keeps the font file around for glyph rendering
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return file ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
+} // namespace
+
+ResourceCache& ResourceCache::instance() {
+    static ResourceCache cache;
+    return cache;
+}
+
+ResourceCache::ResourceCache() :
+    hits(0),
+    misses(0),
+    residentBytes(0),
+    failedCount(0)
+{
+}
+
+template <typename T>
+std::shared_ptr<T> ResourceCache::acquire(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path) {
+    auto it = entries.find(path);
+    if (it != entries.end()) {
+        hits++;
+        return it->second.resource;
+    }
+
+    misses++;
+    std::shared_ptr<T> resource = std::make_shared<T>();
+    if (!resource->loadFromFile(path)) {
+        LOG_ERROR("Failed to load resource", LogField("path", path));
+        Entry<T> failed;
+        failed.bytes = 0;
+        entries.emplace(path, failed);
+        failedCount++;
+        return nullptr;
+    }
+
+    insert(entries, path, resource);
+    return resource;
+}
+
+template <typename T>
+void ResourceCache::insert(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path, const std::shared_ptr<T>& resource) {
+    auto it = entries.find(path);
+    if (it != entries.end() && it->second.resource) {
+        return; // First one wins, whoever holds it keeps using it
+    }
+
+    Entry<T> entry;
+    entry.resource = resource;
+    entry.bytes = residentSize(*resource, path);
+    residentBytes += entry.bytes;
+    if (it != entries.end()) {
+        // Loaded elsewhere after a failed lookup, replaces the failure
+        it->second = entry;
+        failedCount--;
+        return;
+    }
+    entries.emplace(path, entry);
+}
+
+template <typename T>
+void ResourceCache::releaseUnused(std::unordered_map<std::string, Entry<T>>& entries) {
+    for (auto it = entries.begin(); it != entries.end(); /* no increment */) {
+        // Only the cache itself still holds this resource. Failed loads stay.
+        if (it->second.resource.use_count() == 1) {
+            residentBytes -= it->second.bytes;
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+std::shared_ptr<sf::Texture> ResourceCache::getTexture(const std::string& path) {
+    return acquire(textures, path);
+}
+
+std::shared_ptr<sf::SoundBuffer> ResourceCache::getSoundBuffer(const std::string& path) {
+    return acquire(soundBuffers, path);
+}
+
+std::shared_ptr<sf::Font> ResourceCache::getFont(const std::string& path) {
+    return acquire(fonts, path);
+}
+
+void ResourceCache::addTexture(const std::string& path, const std::shared_ptr<sf::Texture>& texture) {
+    misses++;
+    insert(textures, path, texture);
+}
+
+void ResourceCache::addSoundBuffer(const std::string& path, const std::shared_ptr<sf::SoundBuffer>& buffer) {
+    misses++;
+    insert(soundBuffers, path, buffer);
+}
+
+void ResourceCache::addFont(const std::string& path, const std::shared_ptr<sf::Font>& font) {
+    misses++;
+    insert(fonts, path, font);
+}
+
+bool ResourceCache::hasTexture(const std::string& path) const {
+    return textures.count(path) != 0;
+}
+
+void ResourceCache::releaseUnused() {
+    releaseUnused(textures);
+    releaseUnused(soundBuffers);
+    releaseUnused(fonts);
+}
+
+void ResourceCache::clear() {
+    textures.clear();
+    soundBuffers.clear();
+    fonts.clear();
+    residentBytes = 0;
+    failedCount = 0;
+}
+
+std::size_t ResourceCache::getHits() const {
+    return hits;
+}
+
+std::size_t ResourceCache::getMisses() const {
+    return misses;
+}
+
+std::size_t ResourceCache::getResidentBytes() const {
+    return residentBytes;
+}
+
+std::size_t ResourceCache::getResourceCount() const {
+    return textures.size() + soundBuffers.size() + fonts.size() - failedCount;
+}
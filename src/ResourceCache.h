@@ -0,0 +1,72 @@
+#ifndef RESOURCECACHE_H
+#define RESOURCECACHE_H
+
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// Shared, reference-counted store for textures, sound buffers and fonts.
+// Every resource is loaded from disk once and handed out as a shared_ptr,
+// so spawning another enemy never decodes the same PNG or MP3 again.
+class ResourceCache {
+public:
+    static ResourceCache& instance();
+
+    // Return the cached resource for a path, loading it on first use.
+    // Returns nullptr (and logs) if the file could not be loaded; the failure
+    // is cached too, so later lookups return nullptr without touching the disk.
+    // clear() forgets failures.
+    std::shared_ptr<sf::Texture> getTexture(const std::string& path);
+    std::shared_ptr<sf::SoundBuffer> getSoundBuffer(const std::string& path);
+    std::shared_ptr<sf::Font> getFont(const std::string& path);
+
+    // Store a resource loaded elsewhere (see AssetLoader) so later lookups hit
+    void addTexture(const std::string& path, const std::shared_ptr<sf::Texture>& texture);
+    void addSoundBuffer(const std::string& path, const std::shared_ptr<sf::SoundBuffer>& buffer);
+    void addFont(const std::string& path, const std::shared_ptr<sf::Font>& font);
+    // Whether a lookup would hit, without counting it
+    bool hasTexture(const std::string& path) const;
+
+    // Drop every resource nobody outside the cache is holding any more
+    void releaseUnused();
+    void clear();
+
+    // Statistics
+    std::size_t getHits() const;
+    std::size_t getMisses() const;
+    std::size_t getResidentBytes() const;
+    std::size_t getResourceCount() const;
+
+private:
+    ResourceCache();
+    ResourceCache(const ResourceCache&) = delete;
+    ResourceCache& operator=(const ResourceCache&) = delete;
+
+    template <typename T>
+    struct Entry {
+        std::shared_ptr<T> resource; // nullptr when the load failed
+        std::size_t bytes;
+    };
+
+    template <typename T>
+    std::shared_ptr<T> acquire(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path);
+
+    template <typename T>
+    void insert(std::unordered_map<std::string, Entry<T>>& entries, const std::string& path, const std::shared_ptr<T>& resource);
+
+    template <typename T>
+    void releaseUnused(std::unordered_map<std::string, Entry<T>>& entries);
+
+    std::unordered_map<std::string, Entry<sf::Texture>> textures;
+    std::unordered_map<std::string, Entry<sf::SoundBuffer>> soundBuffers;
+    std::unordered_map<std::string, Entry<sf::Font>> fonts;
+
+    std::size_t hits;
+    std::size_t misses;
+    std::size_t residentBytes;
+    std::size_t failedCount; // Entries recording a failed load
+};
+
+#endif // RESOURCECACHE_H
@@ -0,0 +1,282 @@
+#include "SimdKernels.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define SIMD_TARGET_AVX2
+#else
+#define SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+const char* const LEVEL_NAMES[] = { "scalar", "sse2", "avx2" };
+
+SimdLevel detectSimdLevel() {
+#if defined(SIMD_X86)
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        bool avx = (info[2] & (1 << 28)) != 0;
+        // The OS has to save the upper halves of the registers too
+        bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        if (avx && osSavesAvx && (info[1] & (1 << 5)) != 0) {
+            return SIMD_AVX2;
+        }
+    }
+#else
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+#endif
+    return SIMD_SSE2; // Part of every x86-64 CPU
+#else
+    return SIMD_SCALAR;
+#endif
+}
+
+std::atomic<int> activeLevel(-1); // Detected on first use
+
+unsigned char toRange(bool inAttackRange, bool inDetectionRange) {
+    if (inAttackRange) {
+        return ENEMY_IN_ATTACK_RANGE;
+    }
+    return inDetectionRange ? ENEMY_IN_DETECTION_RANGE : ENEMY_OUT_OF_RANGE;
+}
+
+//------------------------------------------------------------------------------
+// Scalar kernels, also finish the tails of the vector ones
+//------------------------------------------------------------------------------
+
+void classifyEnemyRangesScalar(const float* x, const float* attackRange, const float* detectionRange, int count,
+                               float playerX, unsigned char* ranges) {
+    for (int i = 0; i < count; i++) {
+        float distance = std::fabs(playerX - x[i]);
+        ranges[i] = toRange(distance <= attackRange[i], distance <= detectionRange[i]);
+    }
+}
+
+int selectOverlapsYScalar(const float* minY, const float* maxY, int count, float queryMinY, float queryMaxY, int* indices) {
+    int selected = 0;
+    for (int i = 0; i < count; i++) {
+        if (minY[i] < queryMaxY && queryMinY < maxY[i]) {
+            indices[selected++] = i;
+        }
+    }
+    return selected;
+}
+
+#if defined(SIMD_X86)
+
+// Narrow four 32 bit lanes holding small values to bytes
+void storeBytes(unsigned char* out, __m128i lanes) {
+    __m128i narrowed = _mm_packs_epi16(_mm_packs_epi32(lanes, lanes), lanes);
+    int bytes = _mm_cvtsi128_si32(narrowed);
+    std::memcpy(out, &bytes, sizeof(bytes));
+}
+
+// Eight lanes, low four first
+void storeBytes(unsigned char* out, __m128i low, __m128i high) {
+    __m128i narrowed = _mm_packs_epi16(_mm_packs_epi32(low, high), low);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), narrowed);
+}
+
+// The EnemyRange of toRange from two comparison masks: out of range is 2,
+// detection takes 1 off it (adding all ones), attack clears it
+__m128i masksToRange(__m128 attack, __m128 detection) {
+    return _mm_andnot_si128(_mm_castps_si128(attack), _mm_add_epi32(_mm_set1_epi32(ENEMY_OUT_OF_RANGE),
+                                                                   _mm_castps_si128(detection)));
+}
+
+// The set lanes of every four lane mask, packed to the front
+struct LaneList {
+    int lanes[4];
+    int count;
+};
+
+const LaneList LANE_LISTS[16] = {
+    { { 0, 0, 0, 0 }, 0 },
+    { { 0, 0, 0, 0 }, 1 },
+    { { 1, 0, 0, 0 }, 1 },
+    { { 0, 1, 0, 0 }, 2 },
+    { { 2, 0, 0, 0 }, 1 },
+    { { 0, 2, 0, 0 }, 2 },
+    { { 1, 2, 0, 0 }, 2 },
+    { { 0, 1, 2, 0 }, 3 },
+    { { 3, 0, 0, 0 }, 1 },
+    { { 0, 3, 0, 0 }, 2 },
+    { { 1, 3, 0, 0 }, 2 },
+    { { 0, 1, 3, 0 }, 3 },
+    { { 2, 3, 0, 0 }, 2 },
+    { { 0, 2, 3, 0 }, 3 },
+    { { 1, 2, 3, 0 }, 3 },
+    { { 0, 1, 2, 3 }, 4 }
+};
+
+// Append base + lane for every lane set in the low four bits of mask. Always
+// writes four indices, so there is no branch to mispredict; indices past
+// the returned count are overwritten by the next call.
+int appendLanes(int* indices, int selected, int base, int mask) {
+    const LaneList& list = LANE_LISTS[mask & 15];
+    __m128i lanes = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(list.lanes)), _mm_set1_epi32(base));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + selected), lanes);
+    return selected + list.count;
+}
+
+//------------------------------------------------------------------------------
+// SSE2 kernels, four lanes
+//------------------------------------------------------------------------------
+
+void classifyEnemyRangesSse2(const float* x, const float* attackRange, const float* detectionRange, int count,
+                             float playerX, unsigned char* ranges) {
+    const __m128 player = _mm_set1_ps(playerX);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 distance = _mm_andnot_ps(signBit, _mm_sub_ps(player, _mm_loadu_ps(x + i)));
+        __m128 attack = _mm_cmple_ps(distance, _mm_loadu_ps(attackRange + i));
+        __m128 detection = _mm_cmple_ps(distance, _mm_loadu_ps(detectionRange + i));
+        storeBytes(ranges + i, masksToRange(attack, detection));
+    }
+    classifyEnemyRangesScalar(x + i, attackRange + i, detectionRange + i, count - i, playerX, ranges + i);
+}
+
+int selectOverlapsYSse2(const float* minY, const float* maxY, int count, float queryMinY, float queryMaxY, int* indices) {
+    const __m128 queryMin = _mm_set1_ps(queryMinY);
+    const __m128 queryMax = _mm_set1_ps(queryMaxY);
+    int selected = 0;
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 overlap = _mm_and_ps(_mm_cmplt_ps(_mm_loadu_ps(minY + i), queryMax), _mm_cmplt_ps(queryMin, _mm_loadu_ps(maxY + i)));
+        selected = appendLanes(indices, selected, i, _mm_movemask_ps(overlap));
+    }
+    for (; i < count; i++) {
+        if (minY[i] < queryMaxY && queryMinY < maxY[i]) {
+            indices[selected++] = i;
+        }
+    }
+    return selected;
+}
+
+//------------------------------------------------------------------------------
+// AVX2 kernels, eight lanes. Only compares and plain arithmetic, the same
+// operations as the SSE2 ones.
+//------------------------------------------------------------------------------
+
+SIMD_TARGET_AVX2
+void classifyEnemyRangesAvx2(const float* x, const float* attackRange, const float* detectionRange, int count,
+                             float playerX, unsigned char* ranges) {
+    const __m256 player = _mm256_set1_ps(playerX);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 distance = _mm256_andnot_ps(signBit, _mm256_sub_ps(player, _mm256_loadu_ps(x + i)));
+        __m256 attack = _mm256_cmp_ps(distance, _mm256_loadu_ps(attackRange + i), _CMP_LE_OQ);
+        __m256 detection = _mm256_cmp_ps(distance, _mm256_loadu_ps(detectionRange + i), _CMP_LE_OQ);
+        storeBytes(ranges + i, masksToRange(_mm256_castps256_ps128(attack), _mm256_castps256_ps128(detection)),
+                   masksToRange(_mm256_extractf128_ps(attack, 1), _mm256_extractf128_ps(detection, 1)));
+    }
+    classifyEnemyRangesScalar(x + i, attackRange + i, detectionRange + i, count - i, playerX, ranges + i);
+}
+
+SIMD_TARGET_AVX2
+int selectOverlapsYAvx2(const float* minY, const float* maxY, int count, float queryMinY, float queryMaxY, int* indices) {
+    const __m256 queryMin = _mm256_set1_ps(queryMinY);
+    const __m256 queryMax = _mm256_set1_ps(queryMaxY);
+    int selected = 0;
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(minY + i), queryMax, _CMP_LT_OQ),
+                                       _mm256_cmp_ps(queryMin, _mm256_loadu_ps(maxY + i), _CMP_LT_OQ));
+        int mask = _mm256_movemask_ps(overlap);
+        selected = appendLanes(indices, selected, i, mask);
+        selected = appendLanes(indices, selected, i + 4, mask >> 4);
+    }
+    for (; i < count; i++) {
+        if (minY[i] < queryMaxY && queryMinY < maxY[i]) {
+            indices[selected++] = i;
+        }
+    }
+    return selected;
+}
+
+#endif // SIMD_X86
+
+} // namespace
+
+//------------------------------------------------------------------------------
+// Dispatch
+//------------------------------------------------------------------------------
+
+SimdLevel getSupportedSimdLevel() {
+    static const SimdLevel supported = detectSimdLevel();
+    return supported;
+}
+
+SimdLevel getSimdLevel() {
+    int level = activeLevel.load(std::memory_order_relaxed);
+    if (level < 0) {
+        level = getSupportedSimdLevel();
+        activeLevel.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+}
+
+void setSimdLevel(SimdLevel level) {
+    SimdLevel supported = getSupportedSimdLevel();
+    activeLevel.store(level < supported ? level : supported, std::memory_order_relaxed);
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    return LEVEL_NAMES[level];
+}
+
+bool parseSimdLevel(const char* name, SimdLevel& level) {
+    for (int i = SIMD_SCALAR; i <= SIMD_AVX2; i++) {
+        if (std::strcmp(name, LEVEL_NAMES[i]) == 0) {
+            level = static_cast<SimdLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void classifyEnemyRanges(const float* x, const float* attackRange, const float* detectionRange, int count,
+                         float playerX, unsigned char* ranges) {
+    switch (getSimdLevel()) {
+#if defined(SIMD_X86)
+    case SIMD_AVX2:
+        classifyEnemyRangesAvx2(x, attackRange, detectionRange, count, playerX, ranges);
+        return;
+    case SIMD_SSE2:
+        classifyEnemyRangesSse2(x, attackRange, detectionRange, count, playerX, ranges);
+        return;
+#endif
+    default:
+        classifyEnemyRangesScalar(x, attackRange, detectionRange, count, playerX, ranges);
+        return;
+    }
+}
+
+int selectOverlapsY(const float* minY, const float* maxY, int count, float queryMinY, float queryMaxY, int* indices) {
+    switch (getSimdLevel()) {
+#if defined(SIMD_X86)
+    case SIMD_AVX2:
+        return selectOverlapsYAvx2(minY, maxY, count, queryMinY, queryMaxY, indices);
+    case SIMD_SSE2:
+        return selectOverlapsYSse2(minY, maxY, count, queryMinY, queryMaxY, indices);
+#endif
+    default:
+        return selectOverlapsYScalar(minY, maxY, count, queryMinY, queryMaxY, indices);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+// Batch math for the per-tick hot loops, over contiguous float arrays.
+// Every kernel has a scalar version, plus SSE2 and AVX2 versions on x86
+// picked at runtime from what the CPU supports. The vector versions only
+// compare and do the same arithmetic as the scalar ones, so every level
+// gives bit-identical results and the simulation stays deterministic across
+// machines.
+
+enum SimdLevel {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2
+};
+
+// Range of an enemy to the player, see classifyEnemyRanges
+enum EnemyRange {
+    ENEMY_IN_ATTACK_RANGE,
+    ENEMY_IN_DETECTION_RANGE,
+    ENEMY_OUT_OF_RANGE
+};
+
+// Level the kernels run at, the best supported one unless set lower
+SimdLevel getSimdLevel();
+SimdLevel getSupportedSimdLevel();
+// Clamped to the supported level. Set before starting the JobSystem.
+void setSimdLevel(SimdLevel level);
+const char* getSimdLevelName(SimdLevel level);
+// Parse a name from getSimdLevelName, false if unknown
+bool parseSimdLevel(const char* name, SimdLevel& level);
+
+// Horizontal distance of each enemy to playerX against its attack and
+// detection ranges, written to ranges as EnemyRange values
+void classifyEnemyRanges(const float* x, const float* attackRange, const float* detectionRange, int count,
+                         float playerX, unsigned char* ranges);
+
+// Indices of the boxes whose y interval strictly overlaps [queryMinY,
+// queryMaxY], in ascending order. indices needs room for count entries;
+// returns how many were written.
+int selectOverlapsY(const float* minY, const float* maxY, int count, float queryMinY, float queryMaxY, int* indices);
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,214 @@
+#include "SoundPlayer.h"
+#include "ResourceCache.h"
+#include "Log.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const char* const SOUND_FILES[SOUND_COUNT] = {
+    "Assets/shoot.mp3",
+    "Assets/reload.mp3",
+    "Assets/playerdeath.mp3",
+    "Assets/zombiedeath.mp3"
+};
+
+const int DEFAULT_PRIORITY[SOUND_COUNT] = {
+    SOUND_PRIORITY_NORMAL,  // Shoot
+    SOUND_PRIORITY_HIGH,    // Reload, tells the player when they can shoot again
+    SOUND_PRIORITY_CRITICAL,
+    SOUND_PRIORITY_LOW      // Zombie deaths come in crowds
+};
+
+const float AUDIBLE_DISTANCE = 1600.0f; // Pixels; a bit more than a screen away is silent
+const std::chrono::milliseconds DUPLICATE_WINDOW(20); // Same clip again this soon adds nothing
+
+} // namespace
+
+SoundPlayer::SoundPlayer() :
+    listener(0.0f, 0.0f),
+    running(false),
+    activeVoices(0),
+    peakVoices(0),
+    played(0),
+    stolen(0),
+    culled(0),
+    dropped(0)
+{
+    for (Voice& voice : voices) {
+        voice.priority = SOUND_PRIORITY_LOW;
+    }
+}
+
+SoundPlayer::~SoundPlayer() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        running = false;
+    }
+    queueReady.notify_one();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void SoundPlayer::init() {
+    ResourceCache& cache = ResourceCache::instance();
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        buffers[i] = cache.getSoundBuffer(SOUND_FILES[i]);
+        if (!buffers[i]) {
+            LOG_WARN("Missing sound", LogField("path", SOUND_FILES[i]));
+        }
+    }
+
+    running = true;
+    thread = std::thread(&SoundPlayer::run, this);
+}
+
+void SoundPlayer::getSoundPaths(std::vector<std::string>& paths) {
+    for (int i = 0; i < SOUND_COUNT; i++) {
+        paths.push_back(SOUND_FILES[i]);
+    }
+}
+
+void SoundPlayer::play(GameSound clip, int priority, const sf::Vector2f& position) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        Request request = { clip, priority, position, listener };
+        queue.push_back(request);
+    }
+    queueReady.notify_one();
+}
+
+void SoundPlayer::play(const GameEvents& events) {
+    if (events.sounds.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        for (const SoundEvent& event : events.sounds) {
+            Request request = { event.sound, DEFAULT_PRIORITY[event.sound], event.position, listener };
+            queue.push_back(request);
+        }
+    }
+    queueReady.notify_one();
+}
+
+void SoundPlayer::setListener(const sf::Vector2f& position) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    listener = position;
+}
+
+void SoundPlayer::run() {
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            // Wake up now and then anyway to keep the voice count current
+            queueReady.wait_for(lock, std::chrono::milliseconds(100), [this] { return !queue.empty() || !running; });
+            if (!running) {
+                break;
+            }
+            pending.swap(queue);
+        }
+
+        for (const Request& request : pending) {
+            start(request);
+        }
+        pending.clear();
+
+        int active = 0;
+        for (const Voice& voice : voices) {
+            if (voice.sound.getStatus() == sf::Sound::Playing) {
+                active++;
+            }
+        }
+        activeVoices = active;
+        peakVoices = std::max(peakVoices.load(), active);
+    }
+
+    // Sounds have to stop before their buffers go away
+    for (Voice& voice : voices) {
+        voice.sound.stop();
+    }
+}
+
+void SoundPlayer::start(const Request& request) {
+    if (!buffers[request.clip]) {
+        return;
+    }
+
+    // Nobody would hear it
+    float dx = request.position.x - request.listener.x;
+    float dy = request.position.y - request.listener.y;
+    float distance = std::sqrt(dx * dx + dy * dy);
+    if (distance > AUDIBLE_DISTANCE) {
+        culled++;
+        return;
+    }
+
+    // Two zombies dying on the same tick sound like one, only louder
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if (now - lastStart[request.clip] < DUPLICATE_WINDOW) {
+        culled++;
+        return;
+    }
+
+    Voice* voice = findVoice(request.priority);
+    if (!voice) {
+        dropped++;
+        return;
+    }
+    if (voice->sound.getStatus() != sf::Sound::Stopped) {
+        stolen++;
+    }
+
+    voice->sound.stop();
+    voice->sound.setBuffer(*buffers[request.clip]);
+    voice->sound.setVolume(100.0f * (1.0f - 0.5f * distance / AUDIBLE_DISTANCE));
+    voice->sound.play();
+    voice->priority = request.priority;
+    voice->started = now;
+    lastStart[request.clip] = now;
+    played++;
+}
+
+SoundPlayer::Voice* SoundPlayer::findVoice(int priority) {
+    // An idle voice, or else the oldest one with the lowest priority below ours
+    Voice* victim = nullptr;
+    for (Voice& voice : voices) {
+        if (voice.sound.getStatus() == sf::Sound::Stopped) {
+            return &voice;
+        }
+        if (voice.priority >= priority) {
+            continue;
+        }
+        if (!victim || voice.priority < victim->priority ||
+            (voice.priority == victim->priority && voice.started < victim->started)) {
+            victim = &voice;
+        }
+    }
+    return victim;
+}
+
+int SoundPlayer::getActiveVoices() const {
+    return activeVoices;
+}
+
+int SoundPlayer::getPeakVoices() const {
+    return peakVoices;
+}
+
+unsigned int SoundPlayer::getPlayedCount() const {
+    return played;
+}
+
+unsigned int SoundPlayer::getStolenCount() const {
+    return stolen;
+}
+
+unsigned int SoundPlayer::getCulledCount() const {
+    return culled;
+}
+
+unsigned int SoundPlayer::getDroppedCount() const {
+    return dropped;
+}
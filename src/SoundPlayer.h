@@ -0,0 +1,100 @@
+#ifndef SOUNDPLAYER_H
+#define SOUNDPLAYER_H
+
+#include <SFML/Audio.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GameEvents.h"
+
+// Higher priorities steal voices from lower ones
+enum SoundPriority {
+    SOUND_PRIORITY_LOW,
+    SOUND_PRIORITY_NORMAL,
+    SOUND_PRIORITY_HIGH,
+    SOUND_PRIORITY_CRITICAL
+};
+
+// Audio service. Each clip is decoded once (shared through ResourceCache)
+// and played on a fixed pool of voices, well below SFML's limit of about
+// 256 sounds. play() only queues a request; a dedicated audio thread culls
+// sounds too far from the listener or started twice in a row, then picks an
+// idle voice or steals the lowest priority one. Every sf::Sound is touched
+// by that thread only.
+class SoundPlayer {
+public:
+    static const int VOICE_COUNT = 32;
+
+    SoundPlayer();
+    ~SoundPlayer(); // Stops the audio thread
+
+    // Load the clips and start the audio thread
+    void init();
+    // Files init() loads, so they can be decoded ahead of time
+    static void getSoundPaths(std::vector<std::string>& paths);
+
+    // Queue a one-shot sound. Safe to call from any thread.
+    void play(GameSound clip, int priority, const sf::Vector2f& position);
+    // Queue every sound of a tick with its clip's default priority
+    void play(const GameEvents& events);
+    // Where the player hears from, for distance culling and attenuation
+    void setListener(const sf::Vector2f& position);
+
+    // Counters since init
+    int getActiveVoices() const;
+    int getPeakVoices() const;
+    unsigned int getPlayedCount() const;
+    unsigned int getStolenCount() const;  // Started by cutting off a lower priority sound
+    unsigned int getCulledCount() const;  // Out of earshot or a duplicate
+    unsigned int getDroppedCount() const; // Every voice busy with a higher priority sound
+
+private:
+    struct Request {
+        GameSound clip;
+        int priority;
+        sf::Vector2f position;
+        sf::Vector2f listener;
+    };
+
+    struct Voice {
+        sf::Sound sound;
+        int priority;
+        std::chrono::steady_clock::time_point started;
+    };
+
+    SoundPlayer(const SoundPlayer&) = delete;
+    SoundPlayer& operator=(const SoundPlayer&) = delete;
+
+    void run();
+    void start(const Request& request);
+    Voice* findVoice(int priority);
+
+    std::shared_ptr<sf::SoundBuffer> buffers[SOUND_COUNT]; // Shared through ResourceCache
+
+    // Request queue, the only state shared with the game thread
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::vector<Request> queue;
+    sf::Vector2f listener;
+    bool running;
+    std::thread thread;
+
+    // Audio thread only
+    Voice voices[VOICE_COUNT];
+    std::vector<Request> pending; // Swapped with the queue
+    std::chrono::steady_clock::time_point lastStart[SOUND_COUNT];
+
+    std::atomic<int> activeVoices;
+    std::atomic<int> peakVoices;
+    std::atomic<unsigned int> played;
+    std::atomic<unsigned int> stolen;
+    std::atomic<unsigned int> culled;
+    std::atomic<unsigned int> dropped;
+};
+
+#endif // SOUNDPLAYER_H
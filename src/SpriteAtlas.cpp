@@ -0,0 +1,165 @@
+#include "SpriteAtlas.h"
+#include "ResourceCache.h"
+#include "Log.h"
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+// Page files are stored next to the frame table
+std::string tableDirectory(const std::string& tablePath) {
+    std::size_t slash = tablePath.find_last_of('/');
+    if (slash == std::string::npos) {
+        return std::string();
+    }
+    return tablePath.substr(0, slash + 1);
+}
+
+} // namespace
+
+const AtlasFrame& AtlasClip::getFrame(int index) const {
+    static const AtlasFrame emptyFrame = { nullptr, sf::IntRect(0, 0, 0, 0), sf::Vector2f(0.0f, 0.0f) };
+    if (index < 0 || index >= static_cast<int>(frames.size())) {
+        return emptyFrame;
+    }
+    return frames[index];
+}
+
+SpriteAtlas& SpriteAtlas::instance() {
+    static SpriteAtlas atlas;
+    return atlas;
+}
+
+SpriteAtlas::SpriteAtlas() :
+    baked(false)
+{
+}
+
+bool SpriteAtlas::load(const std::string& tablePath) {
+    std::ifstream file(tablePath);
+    if (!file) {
+        // Every strip is then its own texture, a draw call per clip switch
+        LOG_WARN("No sprite atlas, falling back to individual sprite strips, run tools/AtlasBaker",
+                 LogField("path", tablePath));
+        return false;
+    }
+
+    std::string directory = tableDirectory(tablePath);
+
+    std::vector<std::shared_ptr<sf::Texture>> loadedPages;
+    std::unordered_map<std::string, AtlasClip> loadedClips;
+    AtlasClip* currentClip = nullptr;
+    int framesLeft = 0;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        std::istringstream in(line);
+        if (framesLeft > 0) {
+            // Frame line: page x y width height offsetX offsetY
+            std::size_t page;
+            AtlasFrame frame;
+            if (!(in >> page >> frame.rect.left >> frame.rect.top >> frame.rect.width >> frame.rect.height
+                      >> frame.offset.x >> frame.offset.y) || page >= loadedPages.size()) {
+                LOG_ERROR("Malformed atlas frame", LogField("line", line));
+                return false;
+            }
+            frame.texture = frame.rect.width > 0 ? loadedPages[page].get() : nullptr;
+            currentClip->frames.push_back(frame);
+            framesLeft--;
+            continue;
+        }
+
+        std::string keyword;
+        in >> keyword;
+        if (keyword == "page") {
+            std::size_t index;
+            std::string pageFile;
+            in >> index >> pageFile;
+            std::shared_ptr<sf::Texture> texture = ResourceCache::instance().getTexture(directory + pageFile);
+            if (!texture || index != loadedPages.size()) {
+                LOG_ERROR("Failed to load atlas page", LogField("path", pageFile));
+                return false;
+            }
+            loadedPages.push_back(texture);
+        }
+        else if (keyword == "clip") {
+            std::string character, clip;
+            in >> character >> clip >> framesLeft;
+            currentClip = &loadedClips[character + "/" + clip];
+            currentClip->frames.reserve(framesLeft);
+        }
+    }
+
+    pages.swap(loadedPages);
+    clips.swap(loadedClips);
+    baked = true;
+    return true;
+}
+
+bool SpriteAtlas::getPagePaths(const std::string& tablePath, std::vector<std::string>& paths) {
+    std::ifstream file(tablePath);
+    if (!file) {
+        return false;
+    }
+
+    std::string directory = tableDirectory(tablePath);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string keyword;
+        std::size_t index;
+        std::string pageFile;
+        if (in >> keyword && keyword == "page" && in >> index >> pageFile) {
+            paths.push_back(directory + pageFile);
+        }
+    }
+    return true;
+}
+
+std::string SpriteAtlas::getStripPath(const std::string& character, const std::string& clip) {
+    return "Assets/" + character + "/" + clip + ".png";
+}
+
+bool SpriteAtlas::isBaked() const {
+    return baked;
+}
+
+AtlasClip& SpriteAtlas::loadStrip(const std::string& key, const std::string& character, const std::string& clip) {
+    AtlasClip& strip = clips[key];
+    if (baked) {
+        LOG_WARN("Clip missing from the sprite atlas, falling back to its strip, rebake the atlas",
+                 LogField("clip", key));
+    }
+
+    std::shared_ptr<sf::Texture> texture = ResourceCache::instance().getTexture(getStripPath(character, clip));
+    if (!texture) {
+        return strip; // Stays empty, every frame lookup draws nothing
+    }
+    pages.push_back(texture);
+
+    // Untrimmed cells laid out left to right
+    int frameCount = static_cast<int>(texture->getSize().x) / FRAME_SIZE;
+    strip.frames.reserve(frameCount);
+    for (int i = 0; i < frameCount; i++) {
+        AtlasFrame frame = { texture.get(), sf::IntRect(i * FRAME_SIZE, 0, FRAME_SIZE, FRAME_SIZE), sf::Vector2f(0.0f, 0.0f) };
+        strip.frames.push_back(frame);
+    }
+    return strip;
+}
+
+const AtlasClip& SpriteAtlas::getClip(const std::string& character, const std::string& clip) {
+    std::string key = character + "/" + clip;
+    auto it = clips.find(key);
+    if (it != clips.end()) {
+        return it->second;
+    }
+    return loadStrip(key, character, clip);
+}
+
+const AtlasFrame& SpriteAtlas::getFrame(const std::string& character, const std::string& clip, int index) {
+    return getClip(character, clip).getFrame(index);
+}
@@ -0,0 +1,57 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// One animation frame inside an atlas page
+struct AtlasFrame {
+    const sf::Texture* texture; // Page holding the frame (nullptr for an empty frame)
+    sf::IntRect rect;           // Trimmed rectangle on the page
+    sf::Vector2f offset;        // Top-left of the trimmed rectangle inside the original cell
+};
+
+// All frames of one animation strip, e.g. Zombie/Walk
+struct AtlasClip {
+    std::vector<AtlasFrame> frames;
+
+    // Out of range indices give an empty frame, like reading past the end of a strip
+    const AtlasFrame& getFrame(int index) const;
+};
+
+// Frame lookup by (character, clip, index). Uses the baked atlas written by
+// tools/AtlasBaker.cpp when present, and falls back to slicing the original
+// Assets/<character>/<clip>.png strips otherwise.
+class SpriteAtlas {
+public:
+    static const int FRAME_SIZE = 128; // Cell size of the source strips
+
+    static SpriteAtlas& instance();
+
+    // Load a frame table and its pages. Returns false if the table is missing.
+    bool load(const std::string& tablePath);
+    // Page files listed by a frame table, without loading them. Returns false if the table is missing.
+    static bool getPagePaths(const std::string& tablePath, std::vector<std::string>& paths);
+    // File holding the original strip of a clip
+    static std::string getStripPath(const std::string& character, const std::string& clip);
+    bool isBaked() const;
+
+    const AtlasClip& getClip(const std::string& character, const std::string& clip);
+    const AtlasFrame& getFrame(const std::string& character, const std::string& clip, int index);
+
+private:
+    SpriteAtlas();
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+    AtlasClip& loadStrip(const std::string& key, const std::string& character, const std::string& clip);
+
+    std::vector<std::shared_ptr<sf::Texture>> pages;
+    std::unordered_map<std::string, AtlasClip> clips; // Keyed by "character/clip"
+    bool baked;
+};
+
+#endif // SPRITEATLAS_H
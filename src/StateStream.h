@@ -0,0 +1,84 @@
+#ifndef STATESTREAM_H
+#define STATESTREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Raw binary snapshot of simulation state, used for replay keyframes.
+// Values are stored in native byte order; snapshots are only meant to be
+// read back by the same build that wrote them.
+class StateWriter {
+public:
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "state must be plain data");
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), bytes, bytes + sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(const std::vector<T>& values) {
+        write(static_cast<std::uint32_t>(values.size()));
+        for (const T& value : values) {
+            write(value);
+        }
+    }
+
+    const std::vector<char>& getData() const {
+        return data;
+    }
+
+private:
+    std::vector<char> data;
+};
+
+class StateReader {
+public:
+    StateReader(const char* data, std::size_t size) :
+        data(data),
+        size(size),
+        offset(0),
+        good(true)
+    {
+    }
+
+    // Leaves the value untouched and marks the reader bad when the data runs out
+    template <typename T>
+    void read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "state must be plain data");
+        if (!good || size - offset < sizeof(T)) {
+            good = false;
+            return;
+        }
+        std::memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+    }
+
+    template <typename T>
+    void readVector(std::vector<T>& values) {
+        std::uint32_t count = 0;
+        read(count);
+        if (!good || count > (size - offset) / sizeof(T)) {
+            good = false;
+            return;
+        }
+        values.resize(count);
+        for (T& value : values) {
+            read(value);
+        }
+    }
+
+    bool isGood() const {
+        return good;
+    }
+
+private:
+    const char* data;
+    std::size_t size;
+    std::size_t offset;
+    bool good;
+};
+
+#endif // STATESTREAM_H
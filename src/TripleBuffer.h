@@ -0,0 +1,58 @@
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <atomic>
+
+// Lock-free handoff of the newest value from one writer thread to one
+// reader thread. The writer fills its own slot and publishes it, the reader
+// swaps in whatever was published last; neither ever waits for the other,
+// and values the reader was too slow to see are simply skipped.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() :
+        ready(1),
+        writeIndex(0),
+        readIndex(2)
+    {
+    }
+
+    // Writer: the slot to fill next
+    T& getWriteBuffer() {
+        return buffers[writeIndex];
+    }
+
+    // Writer: hand the filled slot to the reader
+    void publish() {
+        writeIndex = ready.exchange(writeIndex | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    // Reader: switch to the newest published slot. Returns false if nothing
+    // was published since the last fetch.
+    bool fetch() {
+        if ((ready.load(std::memory_order_relaxed) & FRESH) == 0) {
+            return false;
+        }
+        readIndex = ready.exchange(readIndex, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    // Reader: the slot fetched last, stays untouched until the next fetch
+    const T& getReadBuffer() const {
+        return buffers[readIndex];
+    }
+
+private:
+    static const unsigned int INDEX_MASK = 3;
+    static const unsigned int FRESH = 4; // Set in `ready` when the writer published it
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    T buffers[3];
+    std::atomic<unsigned int> ready; // Slot index in between, plus the FRESH flag
+    unsigned int writeIndex;         // Only touched by the writer
+    unsigned int readIndex;          // Only touched by the reader
+};
+
+#endif // TRIPLEBUFFER_H
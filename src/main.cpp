@@ -1,225 +1,345 @@
-#include <iostream>
 #include <SFML/Graphics.hpp>
 #include <SFML/Window/Mouse.hpp>
 #include <SFML/Audio.hpp>
-#include "Player.h"
-#include "Bullet.h"
-#include "Enemy.h"
+#include "AssetLoader.h"
+#include "GameInput.h"
+#include "GameWorld.h"
+#include "GameRenderer.h"
+#include "SoundPlayer.h"
+#include "HeadlessRunner.h"
+#include "Replay.h"
+#include "ResourceCache.h"
+#include "SpriteAtlas.h"
+#include "RenderQueue.h"
+#include "RenderThread.h"
+#include "JobSystem.h"
+#include "LevelManager.h"
+#include "Profiler.h"
+#include "SimdKernels.h"
+#include "Log.h"
 
-#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <random>
 using namespace std;
 using namespace sf;
 
 const float VIEW_WIDTH = 1280.f;
 const float VIEW_HEIGHT = 800.f;
 
-// Function to check collision between bullets and enemies
-void checkBulletEnemyCollisions(BulletManager& bulletManager, EnemyManager& enemyManager) {
-    Bullet* bullets = bulletManager.getBullets();
-    int maxBullets = bulletManager.getMaxBullets();
-    
-    for (int i = 0; i < maxBullets; i++) {
-        if (bullets[i].isActive()) {
-            std::vector<Enemy*>& enemies = enemyManager.getEnemies();
-            for (size_t j = 0; j < enemies.size(); ++j) {
-                Enemy* enemy = enemies[j];
-                if (enemy->isAlive() && enemy->getHitbox() &&
-                    enemy->getHitbox()->checkCollision(bullets[i].getBounds())) {
-                    // Apply damage to enemy
-                    enemy->takeDamage(bullets[i].getDamage());
-                    
-                    // Deactivate bullet
-                    bullets[i].setActive(false);
-                    
-                    break; // Break to avoid a single bullet hitting multiple enemies
-                }
-            }
-        }
-    }
+// Simulation runs at a fixed rate, independent of the display rate
+const float DEFAULT_TICK_RATE = 60.f;
+const int MAX_TICKS_PER_FRAME = 5; // Drop time after a hitch instead of spiraling
+const double TRACE_SECONDS = 10.0; // Length of the profiler trace written by F3
+const int LOAD_UPLOAD_BUDGET_MS = 8; // Texture uploads per loading screen frame
+const int PREFETCH_UPLOAD_BUDGET_MS = 2; // Uploads of the next level per gameplay frame
+
+const char* const ATLAS_TABLE_PATH = "Assets/Atlas/atlas.txt";
+const char* const FONT_PATH = "Assets/pixelFont.ttf";
+
+// Snapshot of the keys the simulation cares about
+InputState readKeyboard() {
+    InputState input;
+    input.moveLeft = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.moveRight = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    input.shoot = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    input.reload = sf::Keyboard::isKeyPressed(sf::Keyboard::R);
+    input.throwGrenade = sf::Keyboard::isKeyPressed(sf::Keyboard::G);
+    return input;
 }
 
-// Function to check collision between player and enemies
-void checkPlayerEnemyCollisions(Player& player, EnemyManager& enemyManager) {
-    std::vector<Enemy*>& enemies = enemyManager.getEnemies();
-    for (size_t i = 0; i < enemies.size(); ++i) {
-        Enemy* enemy = enemies[i];
-        if (enemy->isAlive() && enemy->getHitbox() &&
-            enemy->getHitbox()->checkCollision(player.getHitbox().getBounds())) {
-
-            // Only take damage if enemy is attacking
-            if (enemy->isAttacking()) {
-                player.takeDamage(enemy->getAttackDamage());
+int main(int argc, char* argv[]) {
+    // Startup metrics are measured from here
+    sf::Clock startupClock;
+
+    // Optional "--hz <ticks per second>" to change the simulation rate,
+    // "--headless [--ticks <n>]" to run the simulation without a window,
+    // "--seed <n>" to fix the random seed, "--record <file>" to save the run
+    // and "--replay <file> [--seek <tick>]" to play one back, "--profile" to
+    // start with the profiler running, "--jobs <n>" to set the worker count,
+    // "--campaign <file>" to play another list of levels, "--simd
+    // <scalar|sse2|avx2>" to cap the instruction set of the batch kernels
+    float tickRate = DEFAULT_TICK_RATE;
+    bool headless = false;
+    bool seeded = false;
+    unsigned int jobWorkers = 0; // One per spare core
+    HeadlessOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--hz") == 0 && i + 1 < argc) {
+            tickRate = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            options.ticks = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            options.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            options.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+            options.seekTick = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0) {
+            Profiler::instance().setEnabled(true);
+        }
+        else if (std::strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            jobWorkers = static_cast<unsigned int>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--campaign") == 0 && i + 1 < argc) {
+            options.campaignPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--simd") == 0 && i + 1 < argc) {
+            SimdLevel level;
+            if (parseSimdLevel(argv[++i], level)) {
+                setSimdLevel(level);
+            }
+            else {
+                LOG_WARN("Unknown SIMD level", LogField("name", argv[i]));
             }
         }
     }
-}
+    if (tickRate <= 0.f) {
+        tickRate = DEFAULT_TICK_RATE;
+    }
+    float tickDuration = 1.f / tickRate;
+    if (!seeded) {
+        options.seed = std::random_device()();
+    }
+
+    // Parallel loops of the simulation, results don't depend on the worker
+    // count or the SIMD level
+    LOG_INFO("SIMD kernels", LogField("level", getSimdLevelName(getSimdLevel())),
+             LogField("supported", getSimdLevelName(getSupportedSimdLevel())));
+    JobSystem::instance().start(jobWorkers);
+
+    if (headless) {
+        options.tickDuration = tickDuration;
+        return runHeadless(options);
+    }
 
-int main() {
     // Create the window
     RenderWindow window(VideoMode(VIEW_WIDTH, VIEW_HEIGHT), "Zombie Planet: Crashdown");
-    // Load background texture
-    Texture backgroundTexture;
-    if (!backgroundTexture.loadFromFile("Assets/Backgrounds/background.png"))
-    {
-        return -1; // error loading background
+    ResourceCache& resourceCache = ResourceCache::instance();
+
+    // Sprites are batched per layer and texture instead of drawn one by one
+    RenderQueue renderQueue;
+
+    // Level and wave definitions; later levels' assets stream in while playing
+    Campaign campaign;
+    campaign.load(options.campaignPath);
+
+    // Decode every startup asset on worker threads while a loading bar is shown.
+    // The atlas pages (or the raw strips without a baked atlas) are needed
+    // before the renderer can resolve its clips.
+    std::vector<std::string> texturePaths;
+    campaign.getLevel(0).getTexturePaths(texturePaths);
+    if (!SpriteAtlas::getPagePaths(ATLAS_TABLE_PATH, texturePaths)) {
+        GameRenderer::getStripPaths(texturePaths);
     }
-    // Create a sprite using the background texture
-    Sprite backgroundSprite(backgroundTexture);
-    // Scale to fit window
-    Vector2u textureSize = backgroundTexture.getSize();
-    Vector2u windowSize = window.getSize();
-    float scaleX = static_cast<float>(windowSize.x) / textureSize.x;
-    float scaleY = static_cast<float>(windowSize.y) / textureSize.y;
-    backgroundSprite.setScale(scaleX, scaleY);
-    Player player;
-    player.init();
-    
-    // Load and play background music
-    sf::Music backgroundMusic;
-    if (!backgroundMusic.openFromFile("Assets/Damned.mp3")) {
-        std::cerr << "Error loading background music" << std::endl;
-        // Handle error or continue without music
-    } else {
-        backgroundMusic.setLoop(true); // Set music to loop
-        backgroundMusic.play(); // Start playing music
+    std::vector<std::string> soundPaths;
+    SoundPlayer::getSoundPaths(soundPaths);
+
+    AssetLoader assetLoader;
+    for (const std::string& path : texturePaths) {
+        assetLoader.add(ASSET_TEXTURE, path);
+    }
+    for (const std::string& path : soundPaths) {
+        assetLoader.add(ASSET_SOUND_BUFFER, path);
+    }
+    assetLoader.add(ASSET_FONT, FONT_PATH);
+    assetLoader.start();
+
+    sf::Time timeToFirstFrame = sf::Time::Zero;
+    while (window.isOpen() && !assetLoader.isFinished()) {
+        sf::Event event;
+        while (window.pollEvent(event)) {
+            if (event.type == sf::Event::Closed)
+                window.close();
+        }
+
+        assetLoader.update(sf::milliseconds(LOAD_UPLOAD_BUDGET_MS));
+
+        // Progress bar in the middle of the screen
+        const sf::FloatRect bar(VIEW_WIDTH / 4, VIEW_HEIGHT / 2 - 10, VIEW_WIDTH / 2, 20);
+        sf::FloatRect filled = bar;
+        filled.width *= assetLoader.getProgress();
+        window.clear();
+        renderQueue.submit(LAYER_BACKGROUND, bar, sf::Color(60, 60, 60));
+        renderQueue.submit(LAYER_BACKGROUND, filled, sf::Color::White);
+        renderQueue.flush(window);
+        window.display();
+
+        if (timeToFirstFrame == sf::Time::Zero) {
+            timeToFirstFrame = startupClock.getElapsedTime();
+        }
+    }
+    if (!window.isOpen()) {
+        return 0; // Closed while loading
+    }
+
+    // Everything below hits the ResourceCache
+    // Baked sprite atlas (see tools/AtlasBaker.cpp), falls back to the raw strips
+    SpriteAtlas::instance().load(ATLAS_TABLE_PATH);
+    SoundPlayer soundPlayer;
+    soundPlayer.init();
+
+    // Player, bullets, enemies and collisions
+    GameWorld world;
+    world.setCampaign(campaign);
+    Replay replay;
+    bool playingReplay = false;
+    if (!options.replayPath.empty() && replay.load(options.replayPath) &&
+        replay.seek(world, static_cast<std::uint32_t>(options.seekTick))) {
+        // Replay inputs drive the game until they run out, then the keyboard takes over
+        playingReplay = true;
+        tickDuration = 1.f / replay.getTickRate();
+    }
+    else {
+        world.init(options.seed);
+        LOG_INFO("Starting", LogField("seed", options.seed));
+    }
+    Replay recording;
+    bool recordingRun = !options.recordPath.empty() && !playingReplay;
+    if (recordingRun) {
+        recording.begin(options.seed, tickRate);
     }
-    
-    // Create bullet manager and enemy manager
-    BulletManager bulletManager(20);
-    EnemyManager enemyManager;
-    
-    // Variables for shooting control
-    bool canShoot = true;
-    bool canReload = true;
     
     // Font for UI
-    sf::Font font;
-    if (!font.loadFromFile("Assets/pixelFont.ttf")) {
-        cout << "Failed to load font!" << endl;
+    std::shared_ptr<sf::Font> fontResource = resourceCache.getFont(FONT_PATH);
+    if (!fontResource) {
+        LOG_ERROR("Failed to load font", LogField("path", FONT_PATH));
         // Proceed without font
+        fontResource = std::make_shared<sf::Font>();
     }
-    
-    // Ammo display text
-    sf::Text ammoText;
-    ammoText.setFont(font);
-    ammoText.setCharacterSize(24);
-    ammoText.setFillColor(sf::Color::White);
-    ammoText.setPosition(10, 10);
-    
-    // Health display text
-    sf::Text healthText;
-    healthText.setFont(font);
-    healthText.setCharacterSize(24);
-    healthText.setFillColor(sf::Color::White);
-    healthText.setPosition(10, 50);
-
-    // Wave display text
-    sf::Text waveText;
-    waveText.setFont(font);
-    waveText.setCharacterSize(30);
-    waveText.setFillColor(sf::Color::White);
-    waveText.setPosition(VIEW_WIDTH - 200, 10); // Top-right corner
-    
-    // Clock for deltaTime calculation
+
+    // Hitbox debug view, toggled with F1
+    bool showHitboxes = false;
+
+    // Drawing happens on its own thread from per-tick snapshots; this thread
+    // keeps the window events, the input and the simulation
+    const std::size_t assetCount = texturePaths.size() + soundPaths.size() + 1;
+    RenderThread renderThread;
+    renderThread.start(window, *fontResource, tickDuration, [&]() {
+        // First frame of actual gameplay, input is live from here on
+        LOG_INFO("Startup", LogField("first_frame_ms", timeToFirstFrame.asMilliseconds()),
+                 LogField("interactive_ms", startupClock.getElapsedTime().asMilliseconds()),
+                 LogField("assets", assetCount), LogField("workers", assetLoader.getWorkerCount()),
+                 LogField("failed", assetLoader.getFailedCount()));
+    });
+
+    // Backgrounds and music of the level being played
+    LevelManager levelManager;
+    levelManager.init(campaign);
+    levelManager.enter(world.getLevelIndex());
+
+    // Clock for frame time, accumulated into fixed ticks
     sf::Clock clock;
+    float accumulator = 0.f;
+    bool running = true;
     // Main game loop
-    while (window.isOpen()) {
-        // Calculate deltaTime
-        float deltaTime = clock.restart().asSeconds();
+    while (running) {
+        // Clamp so a long stall can't turn into a burst of catch-up ticks
+        float frameTime = clock.restart().asSeconds();
+        accumulator += std::min(frameTime, tickDuration * MAX_TICKS_PER_FRAME);
+
         sf::Event event;
-        while (window.pollEvent(event))
         {
-            if (event.type == sf::Event::Closed)
-                window.close();
-                
-            // Handle key release events for shooting and reloading
-            if (event.type == sf::Event::KeyReleased) {
-                if (event.key.code == sf::Keyboard::Space) {
-                    canShoot = true;
+            PROFILE_ZONE("Events");
+            while (window.pollEvent(event))
+            {
+                if (event.type == sf::Event::Closed)
+                    running = false;
+
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F1) {
+                    showHitboxes = !showHitboxes;
+                }
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F2) {
+                    Profiler::instance().toggle();
                 }
-                if (event.key.code == sf::Keyboard::R) {
-                    canReload = true;
+                if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+                    if (Profiler::isEnabled()) {
+                        Profiler::instance().dumpChromeTrace("profile_" + std::to_string(std::time(nullptr)) + ".json", TRACE_SECONDS);
+                    }
+                    else {
+                        LOG_INFO("Profiler is off, press F2 to start recording");
+                    }
                 }
             }
         }
         
-        player.update(deltaTime);
-        
-        // Handle shooting
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && canShoot && !player.getIsReloading()) {
-            // Get player position and direction
-            float bulletX = player.isFacingRight() ?
-                player.getPosition().x + player.getSize().x - 10.0f :
-                player.getPosition().x - player.getSize().x + 10.0f;
-            float bulletY = player.getPosition().y + player.getSize().y / 1.5;
+        bool ticked = false;
+        while (accumulator >= tickDuration) {
+            PROFILE_ZONE("Tick");
+            // One fixed simulation tick
+            accumulator -= tickDuration;
+            InputState input;
+            if (playingReplay && world.getTickCount() < replay.getTickCount()) {
+                input = replay.getInput(static_cast<std::uint32_t>(world.getTickCount()));
+            }
+            else {
+                input = readKeyboard();
+            }
+            if (recordingRun) {
+                recording.record(world, input);
+            }
+            world.tick(input, tickDuration);
+            renderThread.addEffects(world.getEvents());
+            PROFILE_ZONE("Audio");
+            soundPlayer.setListener(world.getPlayer().getPosition());
+            soundPlayer.play(world.getEvents());
+            ticked = true;
+        }
 
-            bulletManager.fireBullet(bulletX, bulletY, player.isFacingRight());
-            canShoot = false;
+        // The next level was prefetched while this one played
+        if (world.getLevelIndex() != levelManager.getCurrentIndex()) {
+            PROFILE_ZONE("Level::enter");
+            levelManager.enter(world.getLevelIndex());
         }
-        
-        // Handle reload
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::R) && canReload) {
-            bulletManager.reload();
-            canReload = false;
+        levelManager.update(sf::milliseconds(PREFETCH_UPLOAD_BUDGET_MS));
+
+        if (ticked) {
+            PROFILE_ZONE("Snapshot");
+            // Hand the new state to the render thread
+            RenderSnapshot& snapshot = renderThread.getSnapshot();
+            snapshot.capture(world, showHitboxes);
+            snapshot.backgrounds = levelManager.getBackgrounds();
+            renderThread.publishSnapshot();
         }
-        
-        // Update bullets and enemies
-        bulletManager.update(deltaTime);
-        enemyManager.update(deltaTime, player.getPosition());
-        
-        // Check for collisions
-        checkBulletEnemyCollisions(bulletManager, enemyManager);
-        checkPlayerEnemyCollisions(player, enemyManager);
-        
-        // Update ammo display
-        std::stringstream ss;
-        ss << "Ammo: " << bulletManager.getRemainingBullets() << " / 20";
-        ammoText.setString(ss.str());
-        
-        // Update health display
-        std::stringstream healthSS;
-        healthSS << "Health: " << static_cast<int>(player.getHealth());
-        healthText.setString(healthSS.str());
-
-        std::stringstream waveStream;
-        waveStream << "Wave: " << enemyManager.getCurrentWave();
-        waveText.setString(waveStream.str());
-        
+
         // Check if player is dead and death animation is complete
-        if (!player.isAlive() && player.isDeathAnimationComplete()) {
-            // Display game over screen or message
-            sf::Text gameOverText;
-            gameOverText.setFont(font);
-            gameOverText.setString("Game Over!");
-            gameOverText.setCharacterSize(48);
-            gameOverText.setFillColor(sf::Color::Red);
-            gameOverText.setPosition(window.getSize().x / 2 - 150, window.getSize().y / 2 - 50);
-
-            window.clear();
-            window.draw(backgroundSprite);
-            window.draw(gameOverText);
-            window.display();
+        if (world.isGameOver()) {
+            // The render thread shows the game over screen
             sf::sleep(sf::seconds(2)); // Pause for 2 seconds before closing
-            window.close();
+            running = false;
         }
 
-        
-        // Clear window
-        window.clear();
-        // Draw background
-        window.draw(backgroundSprite);
-        // Draw the player sprite
-        player.draw(window);
-        // Draw bullets
-        bulletManager.render(window);
-        //Draw the enemy
-        enemyManager.render(window);
-        // Draw UI
-        window.draw(ammoText);
-        window.draw(healthText);
-        window.draw(waveText);
-        // Display everything
-        window.display();
+        // Nothing to do until the next tick is due
+        sf::sleep(sf::seconds(tickDuration - accumulator - clock.getElapsedTime().asSeconds()));
     }
+
+    renderThread.stop();
+    window.close();
+
+    if (recordingRun) {
+        recording.save(options.recordPath);
+    }
+
+    LOG_INFO("Resources", LogField("loaded", resourceCache.getResourceCount()),
+             LogField("hits", resourceCache.getHits()), LogField("misses", resourceCache.getMisses()),
+             LogField("resident_kb", resourceCache.getResidentBytes() / 1024));
+    LOG_INFO("Audio", LogField("played", soundPlayer.getPlayedCount()), LogField("stolen", soundPlayer.getStolenCount()),
+             LogField("culled", soundPlayer.getCulledCount()), LogField("dropped", soundPlayer.getDroppedCount()),
+             LogField("peak_voices", soundPlayer.getPeakVoices()));
+    Logger::instance().flush();
     return 0;
 }
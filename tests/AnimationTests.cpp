@@ -0,0 +1,86 @@
+// Checks for AnimationPlayer timing.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -Isrc -o animation_tests tests/AnimationTests.cpp src/Animation.cpp
+//   ./animation_tests
+//
+// Prints every failed check and exits with 1 if there was one.
+
+#include "Animation.h"
+#include <cmath>
+#include <iostream>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << std::endl;
+        failures++;
+    }
+}
+
+// Ticks longer than a frame step through every frame that is due
+void testLongTicks() {
+    const AnimationClip& walk = getAnimationClip(CLIP_ZOMBIE_WALK);
+    const float tick = 2.5f * walk.frameDuration;
+    AnimationPlayer player;
+    player.restart(CLIP_ZOMBIE_WALK);
+
+    check(player.update(tick), "a 2.5 frame tick changes the frame");
+    check(player.getFrame() == 2, "a 2.5 frame tick moves two frames");
+    check(player.update(tick), "the second 2.5 frame tick changes the frame");
+    check(player.getFrame() == 5, "the overshoot of 0.5 frames is kept");
+
+    // Four ticks of 2.5 frames are exactly one loop of the 10 frame walk
+    player.restart(CLIP_ZOMBIE_WALK);
+    for (int i = 0; i < 4; i++) {
+        player.update(tick);
+    }
+    check(player.getFrame() == 0, "ten frames of a ten frame loop wrap to the start");
+}
+
+// Time played across many ticks matches the clip's data rate
+void testDataRate() {
+    const AnimationClip& walk = getAnimationClip(CLIP_ZOMBIE_WALK);
+    const float rates[] = { 60.0f, 7.0f, 3.0f };
+    for (float rate : rates) {
+        AnimationPlayer player;
+        player.restart(CLIP_ZOMBIE_WALK);
+        int ticks = static_cast<int>(std::round(rate * 3.0f)); // Three seconds
+        int steps = 0;
+        int previous = player.getFrame();
+        for (int i = 0; i < ticks; i++) {
+            player.update(1.0f / rate);
+            steps += (player.getFrame() - previous + walk.frameCount) % walk.frameCount;
+            previous = player.getFrame();
+        }
+        // Three seconds of 0.1 s frames, give or take the last one
+        check(steps >= 29 && steps <= 30, "clips play at their data rate whatever the tick rate");
+    }
+}
+
+void testHold() {
+    const AnimationClip& dead = getAnimationClip(CLIP_ZOMBIE_DEAD);
+    AnimationPlayer player;
+    player.restart(CLIP_ZOMBIE_DEAD);
+    check(player.update(2.5f * dead.frameDuration), "a hold clip advances");
+    check(player.update(10.0f * dead.frameDuration), "a hold clip reaches its end");
+    check(player.isFinished(), "a hold clip stops on its last frame");
+    check(!player.update(2.5f * dead.frameDuration), "a finished hold clip no longer changes");
+}
+
+} // namespace
+
+int main() {
+    testLongTicks();
+    testDataRate();
+    testHold();
+    if (failures > 0) {
+        std::cerr << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All animation checks passed" << std::endl;
+    return 0;
+}
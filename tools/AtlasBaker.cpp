@@ -0,0 +1,184 @@
+// Offline sprite atlas baker.
+//
+// Packs every horizontal 128x128 animation strip of the given character
+// folders into a few atlas pages, trimming the transparent padding around
+// each frame, and writes the frame table read by SpriteAtlas at runtime.
+//
+// Build and run from the repository root:
+//   g++ -std=c++17 tools/AtlasBaker.cpp -o atlasbaker -lsfml-graphics -lsfml-system
+//   ./atlasbaker Assets/Atlas Assets/Player Assets/Zombie Assets/Zombie_2
+
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+const int FRAME_SIZE = 128; // Cell size of the source strips
+const int PAGE_SIZE = 2048; // Safe texture size for every GL driver we ship on
+const int PADDING = 1;      // Gap between frames so filtering never bleeds
+
+struct Frame {
+    const sf::Image* source;
+    sf::IntRect trimmed;  // Trimmed rectangle inside the source strip
+    sf::Vector2i offset;  // Top-left of the trimmed rectangle inside its cell
+    int page;
+    sf::Vector2i placed;  // Top-left on the atlas page
+};
+
+struct Clip {
+    std::string character;
+    std::string name;
+    std::vector<int> frames; // Indices into the frame list
+};
+
+// Smallest rectangle of the cell containing non-transparent pixels
+sf::IntRect trimCell(const sf::Image& image, int cellX) {
+    int minX = FRAME_SIZE, minY = FRAME_SIZE, maxX = -1, maxY = -1;
+    for (int y = 0; y < FRAME_SIZE; y++) {
+        for (int x = 0; x < FRAME_SIZE; x++) {
+            if (image.getPixel(cellX + x, y).a > 0) {
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+    if (maxX < 0) {
+        return sf::IntRect(0, 0, 0, 0); // Fully transparent cell
+    }
+    return sf::IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <output dir> <character dir>..." << std::endl;
+        return 1;
+    }
+
+    fs::path outputDir = argv[1];
+    std::vector<std::unique_ptr<sf::Image>> images;
+    std::vector<Frame> frames;
+    std::vector<Clip> clips;
+
+    // Slice and trim every strip
+    for (int arg = 2; arg < argc; arg++) {
+        fs::path characterDir = argv[arg];
+        std::vector<fs::path> strips;
+        for (const fs::directory_entry& entry : fs::directory_iterator(characterDir)) {
+            if (entry.path().extension() == ".png") {
+                strips.push_back(entry.path());
+            }
+        }
+        std::sort(strips.begin(), strips.end());
+
+        for (const fs::path& strip : strips) {
+            std::unique_ptr<sf::Image> image(new sf::Image());
+            if (!image->loadFromFile(strip.string())) {
+                std::cerr << "Failed to load " << strip << std::endl;
+                return 1;
+            }
+
+            Clip clip;
+            clip.character = characterDir.filename().string();
+            clip.name = strip.stem().string();
+            int cellCount = static_cast<int>(image->getSize().x) / FRAME_SIZE;
+            for (int cell = 0; cell < cellCount; cell++) {
+                sf::IntRect trimmed = trimCell(*image, cell * FRAME_SIZE);
+                Frame frame;
+                frame.source = image.get();
+                frame.offset = sf::Vector2i(trimmed.left, trimmed.top);
+                frame.trimmed = sf::IntRect(cell * FRAME_SIZE + trimmed.left, trimmed.top, trimmed.width, trimmed.height);
+                frame.page = 0;
+                clip.frames.push_back(static_cast<int>(frames.size()));
+                frames.push_back(frame);
+            }
+            clips.push_back(clip);
+            images.push_back(std::move(image));
+        }
+    }
+
+    // Shelf packing, tallest frames first
+    std::vector<int> order(frames.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = static_cast<int>(i);
+    }
+    std::sort(order.begin(), order.end(), [&frames](int a, int b) {
+        if (frames[a].trimmed.height != frames[b].trimmed.height) {
+            return frames[a].trimmed.height > frames[b].trimmed.height;
+        }
+        return frames[a].trimmed.width > frames[b].trimmed.width;
+    });
+
+    int pageCount = 1;
+    int cursorX = 0, cursorY = 0, shelfHeight = 0;
+    for (int index : order) {
+        Frame& frame = frames[index];
+        if (frame.trimmed.width == 0) {
+            continue; // Empty frames take no space
+        }
+        if (cursorX + frame.trimmed.width > PAGE_SIZE) {
+            // Start a new shelf
+            cursorX = 0;
+            cursorY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        if (cursorY + frame.trimmed.height > PAGE_SIZE) {
+            // Start a new page
+            pageCount++;
+            cursorX = 0;
+            cursorY = 0;
+            shelfHeight = 0;
+        }
+        frame.page = pageCount - 1;
+        frame.placed = sf::Vector2i(cursorX, cursorY);
+        cursorX += frame.trimmed.width + PADDING;
+        shelfHeight = std::max(shelfHeight, frame.trimmed.height);
+    }
+
+    // Copy frames onto the pages
+    fs::create_directories(outputDir);
+    std::vector<sf::Image> pages(pageCount);
+    for (sf::Image& page : pages) {
+        page.create(PAGE_SIZE, PAGE_SIZE, sf::Color::Transparent);
+    }
+    for (const Frame& frame : frames) {
+        if (frame.trimmed.width > 0) {
+            pages[frame.page].copy(*frame.source, frame.placed.x, frame.placed.y, frame.trimmed);
+        }
+    }
+    for (int i = 0; i < pageCount; i++) {
+        std::string pageFile = (outputDir / ("atlas_" + std::to_string(i) + ".png")).string();
+        if (!pages[i].saveToFile(pageFile)) {
+            std::cerr << "Failed to write " << pageFile << std::endl;
+            return 1;
+        }
+    }
+
+    // Frame table: pages, then each clip followed by one line per frame
+    std::ofstream table(outputDir / "atlas.txt");
+    table << "# Generated by tools/AtlasBaker.cpp, do not edit\n";
+    table << "# clip <character> <clip> <frames>, then: page x y width height offsetX offsetY\n";
+    for (int i = 0; i < pageCount; i++) {
+        table << "page " << i << " atlas_" << i << ".png\n";
+    }
+    for (const Clip& clip : clips) {
+        table << "clip " << clip.character << " " << clip.name << " " << clip.frames.size() << "\n";
+        for (int index : clip.frames) {
+            const Frame& frame = frames[index];
+            table << frame.page << " " << frame.placed.x << " " << frame.placed.y << " "
+                  << frame.trimmed.width << " " << frame.trimmed.height << " "
+                  << frame.offset.x << " " << frame.offset.y << "\n";
+        }
+    }
+
+    std::cout << "Packed " << frames.size() << " frames from " << clips.size() << " strips into "
+              << pageCount << " page(s) in " << outputDir.string() << std::endl;
+    return 0;
+}